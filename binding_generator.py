@@ -270,7 +270,7 @@ def generate_class_header(used_classes, c, use_template_get_node):
     )
 
     source.append(
-        "\tstatic inline Object *___get_from_variant(Variant a) { pandemonium_object *o = (pandemonium_object*) a; return (o) ? (Object *) Pandemonium::nativescript_api->pandemonium_nativescript_get_instance_binding_data(_RegisterState::language_index, o) : nullptr; }"
+        "\tstatic inline Object *___get_from_variant(Variant a) { pandemonium_object *o = (pandemonium_object*) a; return (o) ? (Object *) _WrapperCache::get(o) : nullptr; }"
     )
 
     enum_values = []
@@ -302,6 +302,11 @@ def generate_class_header(used_classes, c, use_template_get_node):
         source.append("\tstatic T *cast_to(const Object *obj);")
         source.append("#endif")
         source.append("")
+        source.append("\ttemplate <class... Args>")
+        source.append("\tError emit_signal(const SignalHandle &signal, const Args &...args) {")
+        source.append("\t\treturn signal.emit(this, args...);")
+        source.append("\t}")
+        source.append("")
 
     for method in c["methods"]:
         method_signature = ""
@@ -314,12 +319,14 @@ def generate_class_header(used_classes, c, use_template_get_node):
 
         has_default_argument = False
         method_arguments = ""
+        method_parameters = ""
 
         for i, argument in enumerate(method["arguments"]):
             method_signature += "const " + make_gdnative_type(argument["type"], ref_allowed)
             argument_name = escape_cpp(argument["name"])
             method_signature += argument_name
             method_arguments += argument_name
+            method_parameters += "const " + make_gdnative_type(argument["type"], ref_allowed) + argument_name + ", "
 
             # default arguments
             def escape_default_arg(_type, default_value):
@@ -392,15 +399,39 @@ def generate_class_header(used_classes, c, use_template_get_node):
             if len(method["arguments"]) > 0:
                 method_signature += ", "
                 method_arguments += ", "
+            const_suffix = " const" if method["is_const"] else ""
+
+            # All varargs overloads end up here, with pointers to the extra arguments.
+            source.append(
+                "\t"
+                + make_gdnative_type(method["return_type"], ref_allowed)
+                + "___"
+                + method["name"]
+                + "_varargs("
+                + method_parameters
+                + "const Variant **__var_args, int __var_arg_count)"
+                + const_suffix
+                + ";"
+            )
+
+            # Boxes the extra arguments on the stack, instead of going through an Array.
             vararg_templates += (
                 "\ttemplate <class... Args> "
                 + method_signature
-                + "Args... args){\n\t\treturn "
-                + method_name
-                + "("
+                + "const Args &...args)"
+                + const_suffix
+                + " {\n"
+                + "\t\tconst Variant __boxed[] = { Variant(args)... };\n"
+                + "\t\tconst Variant *__boxed_ptrs[sizeof...(Args)];\n"
+                + "\t\tfor (int i = 0; i < (int)sizeof...(Args); i++) {\n"
+                + "\t\t\t__boxed_ptrs[i] = &__boxed[i];\n"
+                + "\t\t}\n"
+                + "\t\treturn ___"
+                + method["name"]
+                + "_varargs("
                 + method_arguments
-                + "Array::make(args...));\n\t}\n"
-                ""
+                + "__boxed_ptrs, sizeof...(Args));\n"
+                + "\t}\n"
             )
             method_signature += "const Array& __var_args = Array()"
 
@@ -413,7 +444,7 @@ def generate_class_header(used_classes, c, use_template_get_node):
     if use_template_get_node and class_name == "Node":
         # Extra definition for template get_node that calls the renamed get_node_internal; has a default template parameter for backwards compatibility.
         source.append("\ttemplate <class T = Node>")
-        source.append("\tT *get_node(const NodePath path) const {")
+        source.append("\tT *get_node(const NodePath &path) const {")
         source.append("\t\treturn Object::cast_to<T>(get_node_internal(path));")
         source.append("\t}")
 
@@ -422,7 +453,7 @@ def generate_class_header(used_classes, c, use_template_get_node):
 
         # ...And a specialized version so we don't unnecessarily cast when using the default.
         source.append("template <>")
-        source.append("inline Node *Node::get_node<Node>(const NodePath path) const {")
+        source.append("inline Node *Node::get_node<Node>(const NodePath &path) const {")
         source.append("\treturn get_node_internal(path);")
         source.append("}")
         source.append("")
@@ -541,7 +572,26 @@ def generate_class_implementation(icalls, used_classes, c, use_template_get_node
         if method["has_varargs"]:
             if len(method["arguments"]) > 0:
                 method_signature += ", "
-            method_signature += "const Array& __var_args"
+
+            forwarded_arguments = ""
+            for argument in method["arguments"]:
+                forwarded_arguments += escape_cpp(argument["name"]) + ", "
+
+            source.append(method_signature + "const Array& __var_args)" + (" const" if method["is_const"] else "") + " {")
+            source.append("\tconst Variant **__args = (const Variant **) alloca(sizeof(const Variant *) * __var_args.size());")
+            source.append("\tfor (int i = 0; i < __var_args.size(); i++) {")
+            source.append("\t\t__args[i] = &__var_args[i];")
+            source.append("\t}")
+            source.append(
+                "\treturn ___" + method["name"] + "_varargs(" + forwarded_arguments + "__args, __var_args.size());"
+            )
+            source.append("}")
+            source.append("")
+
+            method_signature = method_signature.replace(
+                "::" + escape_cpp(method["name"]) + "(", "::___" + method["name"] + "_varargs(", 1
+            )
+            method_signature += "const Variant **__var_args, int __var_arg_count"
 
         method_signature += ")" + (" const" if method["is_const"] else "")
 
@@ -580,21 +630,16 @@ def generate_class_implementation(icalls, used_classes, c, use_template_get_node
         if method["has_varargs"]:
 
             if len(method["arguments"]) != 0:
-                source.append("\tVariant __given_args[" + str(len(method["arguments"])) + "];")
-
-            for i, argument in enumerate(method["arguments"]):
-                source.append("\tPandemonium::api->pandemonium_variant_new_nil((pandemonium_variant *) &__given_args[" + str(i) + "]);")
-
-            source.append("")
-
-            for i, argument in enumerate(method["arguments"]):
-                source.append("\t__given_args[" + str(i) + "] = " + escape_cpp(argument["name"]) + ";")
+                given_args = []
+                for argument in method["arguments"]:
+                    given_args.append("Variant(" + escape_cpp(argument["name"]) + ")")
+                source.append("\tconst Variant __given_args[] = { " + ", ".join(given_args) + " };")
 
             source.append("")
 
             size = ""
             if method["has_varargs"]:
-                size = "(__var_args.size() + " + str(len(method["arguments"])) + ")"
+                size = "(__var_arg_count + " + str(len(method["arguments"])) + ")"
             else:
                 size = "(" + str(len(method["arguments"])) + ")"
 
@@ -610,11 +655,11 @@ def generate_class_implementation(icalls, used_classes, c, use_template_get_node
             source.append("")
 
             if method["has_varargs"]:
-                source.append("\tfor (int i = 0; i < __var_args.size(); i++) {")
+                source.append("\tfor (int i = 0; i < __var_arg_count; i++) {")
                 source.append(
                     "\t\t__args[i + "
                     + str(len(method["arguments"]))
-                    + "] = (pandemonium_variant *) &((Array &) __var_args)[i];"
+                    + "] = (pandemonium_variant *) __var_args[i];"
                 )
                 source.append("\t}")
 
@@ -640,10 +685,6 @@ def generate_class_implementation(icalls, used_classes, c, use_template_get_node
 
                 source.append("")
 
-            for i, argument in enumerate(method["arguments"]):
-                source.append("\tPandemonium::api->pandemonium_variant_destroy((pandemonium_variant *) &__given_args[" + str(i) + "]);")
-
-            source.append("")
 
             if method["return_type"] != "void":
                 cast = ""
@@ -778,7 +819,7 @@ def generate_icall_header(icalls):
             if is_class_type(ret_type):
                 source.append("\tif (ret) {")
                 source.append(
-                    "\t\treturn (Object *) Pandemonium::nativescript_api->pandemonium_nativescript_get_instance_binding_data(_RegisterState::language_index, ret);"
+                    "\t\treturn (Object *) _WrapperCache::get(ret);"
                 )
                 source.append("\t}")
                 source.append("")
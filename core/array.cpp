@@ -71,6 +71,10 @@ Array::Array(const PoolVector2Array &a) {
 	Pandemonium::api->pandemonium_array_new_pool_vector2_array(&_pandemonium_array, (pandemonium_pool_vector2_array *)&a);
 }
 
+Array::Array(const PoolVector2iArray &a) {
+	Pandemonium::api->pandemonium_array_new_pool_vector2i_array(&_pandemonium_array, (pandemonium_pool_vector2i_array *)&a);
+}
+
 Array::Array(const PoolVector3Array &a) {
 	Pandemonium::api->pandemonium_array_new_pool_vector3_array(&_pandemonium_array, (pandemonium_pool_vector3_array *)&a);
 }
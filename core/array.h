@@ -36,38 +36,26 @@
 class String;
 
 namespace helpers {
-template <typename T, typename ValueT>
-T append_all(T appendable, ValueT value) {
-	appendable.append(value);
-	return appendable;
+// The containers and values are passed by reference down the recursion,
+// so building one with N values makes no copies of it along the way.
+template <typename T>
+void append_all(T & /*appendable*/) {
 }
 
 template <typename T, typename ValueT, typename... Args>
-T append_all(T appendable, ValueT value, Args... args) {
+void append_all(T &appendable, const ValueT &value, const Args &...args) {
 	appendable.append(value);
-	return append_all(appendable, args...);
-}
-
-template <typename T>
-T append_all(T appendable) {
-	return appendable;
+	append_all(appendable, args...);
 }
 
-template <typename KV, typename KeyT, typename ValueT>
-KV add_all(KV kv, KeyT key, ValueT value) {
-	kv[key] = value;
-	return kv;
+template <typename KV>
+void add_all(KV & /*kv*/) {
 }
 
 template <typename KV, typename KeyT, typename ValueT, typename... Args>
-KV add_all(KV kv, KeyT key, ValueT value, Args... args) {
+void add_all(KV &kv, const KeyT &key, const ValueT &value, const Args &...args) {
 	kv[key] = value;
-	return add_all(kv, args...);
-}
-
-template <typename KV>
-KV add_all(KV kv) {
-	return kv;
+	add_all(kv, args...);
 }
 } // namespace helpers
 
@@ -77,6 +65,7 @@ class PoolIntArray;
 class PoolRealArray;
 class PoolStringArray;
 class PoolVector2Array;
+class PoolVector2iArray;
 class PoolVector3Array;
 class PoolColorArray;
 
@@ -107,13 +96,17 @@ public:
 
 	Array(const PoolVector2Array &a);
 
+	Array(const PoolVector2iArray &a);
+
 	Array(const PoolVector3Array &a);
 
 	Array(const PoolColorArray &a);
 
 	template <class... Args>
-	static Array make(Args... args) {
-		return helpers::append_all(Array(), args...);
+	static Array make(const Args &...args) {
+		Array array;
+		helpers::append_all(array, args...);
+		return array;
 	}
 
 	Variant &operator[](const int idx);
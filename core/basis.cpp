@@ -183,6 +183,7 @@ Vector3 Basis::get_scale() const {
 Basis Basis::slerp(Basis b, float t) const {
 	ERR_FAIL_COND_V(!is_rotation(), Basis());
 	ERR_FAIL_COND_V(!b.is_rotation(), Basis());
+	// With PANDEMONIUM_FAST_MATH this goes through the Math::fast version of Quaternion::slerp.
 	Quaternion from(*this);
 	Quaternion to(b);
 	return Basis(from.slerp(to, t));
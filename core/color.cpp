@@ -30,11 +30,17 @@
 
 #include "color.h"
 #include "defs.h"
+#include "math_funcs.h"
 #include "ustring.h"
 
 #include <gdn/color.h>
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLOR_SSE2
+#include <emmintrin.h>
+#endif
+
 static String _to_hex(float p_val);
 
 static float _parse_col(const String &p_str, int p_ofs) {
@@ -222,8 +228,18 @@ void Color::set_hsv(float p_h, float p_s, float p_v, float p_alpha) {
 	}
 
 	p_h *= 6.0;
+#ifdef PANDEMONIUM_FAST_MATH
+	// Wraps negative hues too, instead of falling through to the last sector.
+	p_h -= 6.0f * Math::fast::floor(p_h * (1.0f / 6.0f));
+	if (p_h >= 6.0f) {
+		// Rounding of tiny negative hues.
+		p_h = 0.0f;
+	}
+	i = Math::fast::floor(p_h);
+#else
 	p_h = ::fmod(p_h, 6);
 	i = ::floor(p_h);
+#endif
 
 	f = p_h - i;
 	p = p_v * (1 - p_s);
@@ -387,6 +403,249 @@ Color Color::to_linear() const {
 			a);
 }
 
+void Color::to_rgba8_n(const Color *p_src, uint8_t *r_dst, int p_count) {
+	int i = 0;
+#ifdef COLOR_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(255.0f);
+	for (; i + 4 <= p_count; i += 4) {
+		const float *src = p_src[i].components;
+		__m128i c0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src), zero), one), scale));
+		__m128i c1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 4), zero), one), scale));
+		__m128i c2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 8), zero), one), scale));
+		__m128i c3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 12), zero), one), scale));
+		__m128i packed = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+		_mm_storeu_si128((__m128i *)(r_dst + i * 4), packed);
+	}
+#endif
+	for (; i < p_count; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			r_dst[i * 4 + j] = (uint8_t)(CLAMP(p_src[i].components[j], 0.0f, 1.0f) * 255.0f + 0.5f);
+		}
+	}
+}
+
+void Color::from_rgba8_n(const uint8_t *p_src, Color *r_dst, int p_count) {
+	int i = 0;
+#ifdef COLOR_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+	for (; i + 4 <= p_count; i += 4) {
+		__m128i bytes = _mm_loadu_si128((const __m128i *)(p_src + i * 4));
+		__m128i lo = _mm_unpacklo_epi8(bytes, zero);
+		__m128i hi = _mm_unpackhi_epi8(bytes, zero);
+		float *dst = r_dst[i].components;
+		_mm_storeu_ps(dst, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+		_mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+		_mm_storeu_ps(dst + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+		_mm_storeu_ps(dst + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			r_dst[i].components[j] = p_src[i * 4 + j] * (1.0f / 255.0f);
+		}
+	}
+}
+
+void Color::to_rgba16_n(const Color *p_src, uint16_t *r_dst, int p_count) {
+	int i = 0;
+#ifdef COLOR_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(65535.0f);
+	const __m128i bias = _mm_set1_epi32(32768);
+	const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+	for (; i + 2 <= p_count; i += 2) {
+		const float *src = p_src[i].components;
+		__m128i c0 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src), zero), one), scale));
+		__m128i c1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 4), zero), one), scale));
+		// SSE2 only has a signed 32 to 16 bit pack, so shift the range around it.
+		__m128i packed = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(c0, bias), _mm_sub_epi32(c1, bias)), bias16);
+		_mm_storeu_si128((__m128i *)(r_dst + i * 4), packed);
+	}
+#endif
+	for (; i < p_count; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			r_dst[i * 4 + j] = (uint16_t)(CLAMP(p_src[i].components[j], 0.0f, 1.0f) * 65535.0f + 0.5f);
+		}
+	}
+}
+
+void Color::from_rgba16_n(const uint16_t *p_src, Color *r_dst, int p_count) {
+	int i = 0;
+#ifdef COLOR_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 scale = _mm_set1_ps(1.0f / 65535.0f);
+	for (; i + 2 <= p_count; i += 2) {
+		__m128i words = _mm_loadu_si128((const __m128i *)(p_src + i * 4));
+		float *dst = r_dst[i].components;
+		_mm_storeu_ps(dst, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero)), scale));
+		_mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(words, zero)), scale));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			r_dst[i].components[j] = p_src[i * 4 + j] * (1.0f / 65535.0f);
+		}
+	}
+}
+
+// Blocks of colors go through Math::fast::pow_n(), which works on flat float arrays.
+static const int COLOR_BATCH_BLOCK = 64;
+
+void Color::to_linear_n(const Color *p_src, Color *r_dst, int p_count) {
+	float curve[COLOR_BATCH_BLOCK * 4];
+
+	for (int base = 0; base < p_count; base += COLOR_BATCH_BLOCK) {
+		const int count = MIN(COLOR_BATCH_BLOCK, p_count - base);
+		const Color *src = p_src + base;
+
+		for (int i = 0; i < count * 4; ++i) {
+			curve[i] = (src->components[i] + 0.055f) * (1.0f / (1.0f + 0.055f));
+		}
+		Math::fast::pow_n(curve, 2.4f, curve, count * 4);
+
+		for (int i = 0; i < count; ++i) {
+			Color &dst = r_dst[base + i];
+			for (int j = 0; j < 3; ++j) {
+				float c = src[i].components[j];
+				dst.components[j] = c < 0.04045f ? c * (1.0f / 12.92f) : curve[i * 4 + j];
+			}
+			dst.a = src[i].a;
+		}
+	}
+}
+
+void Color::to_srgb_n(const Color *p_src, Color *r_dst, int p_count) {
+	float curve[COLOR_BATCH_BLOCK * 4];
+
+	for (int base = 0; base < p_count; base += COLOR_BATCH_BLOCK) {
+		const int count = MIN(COLOR_BATCH_BLOCK, p_count - base);
+		const Color *src = p_src + base;
+
+		Math::fast::pow_n(src->components, 1.0f / 2.4f, curve, count * 4);
+
+		for (int i = 0; i < count; ++i) {
+			Color &dst = r_dst[base + i];
+			for (int j = 0; j < 3; ++j) {
+				float c = src[i].components[j];
+				dst.components[j] = c < 0.0031308f ? c * 12.92f : (1.0f + 0.055f) * curve[i * 4 + j] - 0.055f;
+			}
+			dst.a = src[i].a;
+		}
+	}
+}
+
+void Color::from_srgb8_n(const uint8_t *p_src, Color *r_dst, int p_count) {
+	struct SRGBTable {
+		float values[256];
+
+		SRGBTable() {
+			for (int i = 0; i < 256; ++i) {
+				double c = i / 255.0;
+				values[i] = c < 0.04045 ? c * (1.0 / 12.92) : ::pow((c + 0.055) * (1.0 / (1 + 0.055)), 2.4);
+			}
+		}
+	};
+	static const SRGBTable table;
+
+	for (int i = 0; i < p_count; ++i) {
+		const uint8_t *src = p_src + i * 4;
+		r_dst[i] = Color(table.values[src[0]], table.values[src[1]], table.values[src[2]], src[3] * (1.0f / 255.0f));
+	}
+}
+
+void Color::premultiply_alpha_n(const Color *p_src, Color *r_dst, int p_count) {
+	int i = 0;
+#ifdef COLOR_SSE2
+	const __m128 alpha_mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+	for (; i < p_count; ++i) {
+		__m128 c = _mm_loadu_ps(p_src[i].components);
+		__m128 a = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+		// Multiply everything but alpha.
+		__m128 m = _mm_or_ps(_mm_andnot_ps(alpha_mask, a), _mm_and_ps(alpha_mask, _mm_set1_ps(1.0f)));
+		_mm_storeu_ps(r_dst[i].components, _mm_mul_ps(c, m));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		const Color &src = p_src[i];
+		r_dst[i] = Color(src.r * src.a, src.g * src.a, src.b * src.a, src.a);
+	}
+}
+
+void Color::unpremultiply_alpha_n(const Color *p_src, Color *r_dst, int p_count) {
+	int i = 0;
+#ifdef COLOR_SSE2
+	const __m128 alpha_mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i < p_count; ++i) {
+		__m128 c = _mm_loadu_ps(p_src[i].components);
+		__m128 a = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+		__m128 visible = _mm_cmpneq_ps(a, zero);
+		// 1 / alpha, or 0 for transparent colors, without dividing by zero.
+		__m128 inv = _mm_and_ps(visible, _mm_div_ps(one, _mm_or_ps(_mm_and_ps(visible, a), _mm_andnot_ps(visible, one))));
+		__m128 m = _mm_or_ps(_mm_andnot_ps(alpha_mask, inv), _mm_and_ps(alpha_mask, one));
+		_mm_storeu_ps(r_dst[i].components, _mm_mul_ps(c, m));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		const Color &src = p_src[i];
+		float inv = src.a != 0 ? 1.0f / src.a : 0.0f;
+		r_dst[i] = Color(src.r * inv, src.g * inv, src.b * inv, src.a);
+	}
+}
+
+void Color::to_hsv_n(const Color *p_src, Color *r_dst, int p_count) {
+	for (int i = 0; i < p_count; ++i) {
+		const Color &src = p_src[i];
+		float min = MIN(MIN(src.r, src.g), src.b);
+		float max = MAX(MAX(src.r, src.g), src.b);
+		float delta = max - min;
+
+		float h = 0;
+		if (delta != 0) {
+			// Same sectors as get_h().
+			if (src.r == max) {
+				h = (src.g - src.b) / delta;
+			} else if (src.g == max) {
+				h = 2 + (src.b - src.r) / delta;
+			} else {
+				h = 4 + (src.r - src.g) / delta;
+			}
+			h *= 1.0f / 6.0f;
+			if (h < 0) {
+				h += 1.0f;
+			}
+		}
+
+		r_dst[i] = Color(h, max != 0 ? delta / max : 0, max, src.a);
+	}
+}
+
+void Color::from_hsv_n(const Color *p_src, Color *r_dst, int p_count) {
+	for (int i = 0; i < p_count; ++i) {
+		const Color &src = p_src[i];
+		float h = src.r * 6.0f;
+		h -= 6.0f * Math::fast::floor(h * (1.0f / 6.0f));
+		const float c = src.b * src.g;
+
+		// Branchless form of the sector switch in from_hsv(), which lets the loop vectorise:
+		// channel = v - c * clamp(min(k, 4 - k), 0, 1), with k = (n + h) mod 6 and n = 5, 3, 1 for r, g, b.
+		float rgb[3];
+		const float offsets[3] = { 5.0f, 3.0f, 1.0f };
+		for (int j = 0; j < 3; ++j) {
+			float k = offsets[j] + h;
+			k = k >= 6.0f ? k - 6.0f : k;
+			rgb[j] = src.b - c * CLAMP(MIN(k, 4.0f - k), 0.0f, 1.0f);
+		}
+
+		r_dst[i] = Color(rgb[0], rgb[1], rgb[2], src.a);
+	}
+}
+
 Color Color::hex(uint32_t p_hex) {
 	float a = (p_hex & 0xFF) / 255.0;
 	p_hex >>= 8;
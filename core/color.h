@@ -131,6 +131,29 @@ public:
 
 	Color to_linear() const;
 
+	// Batched conversions for image sized buffers, such as the Read and Write pointers of PoolColorArray and PoolByteArray.
+	// 8 and 16 bit data is in RGBA order. Unlike to_RGBA32() and friends, conversions to integers clamp to [0, 1] and round to nearest.
+	// Conversions to and from 8 and 16 bit data write a value of the other type for each color, so the destination must not overlap the source.
+	// The Color to Color conversions below work one color at a time, and may be given the same buffer as both source and destination.
+	static void to_rgba8_n(const Color *p_src, uint8_t *r_dst, int p_count);
+	static void from_rgba8_n(const uint8_t *p_src, Color *r_dst, int p_count);
+	static void to_rgba16_n(const Color *p_src, uint16_t *r_dst, int p_count);
+	static void from_rgba16_n(const uint16_t *p_src, Color *r_dst, int p_count);
+
+	// sRGB transfer function on the color channels, alpha is kept as is.
+	// to_linear_n() matches to_linear() up to the Math::fast::pow() error, from_srgb8_n() decodes 8 bit data through a lookup table.
+	static void to_linear_n(const Color *p_src, Color *r_dst, int p_count);
+	static void to_srgb_n(const Color *p_src, Color *r_dst, int p_count);
+	static void from_srgb8_n(const uint8_t *p_src, Color *r_dst, int p_count);
+
+	// Fully transparent colors unpremultiply to transparent black.
+	static void premultiply_alpha_n(const Color *p_src, Color *r_dst, int p_count);
+	static void unpremultiply_alpha_n(const Color *p_src, Color *r_dst, int p_count);
+
+	// HSV values are packed into the r, g and b components, with hue in [0, 1) like get_h(). Alpha is kept as is.
+	static void to_hsv_n(const Color *p_src, Color *r_dst, int p_count);
+	static void from_hsv_n(const Color *p_src, Color *r_dst, int p_count);
+
 	static Color hex(uint32_t p_hex);
 
 	static Color html(const String &p_color);
@@ -100,6 +100,20 @@ static inline uint32_t hash_one_uint64(const uint64_t p_int) {
 	return (uint32_t)v;
 }
 
+// Hashes for integer grid coordinates, such as chunk keys of voxel maps.
+// The axes are packed into a single 64 bit key, which then only needs one mixing round
+// instead of one murmur3 round per axis. Neighbouring cells still end up in unrelated buckets.
+static _FORCE_INLINE_ uint32_t hash_grid_2i(int32_t p_x, int32_t p_y) {
+	return hash_one_uint64((uint64_t)(uint32_t)p_x | ((uint64_t)(uint32_t)p_y << 32));
+}
+
+static _FORCE_INLINE_ uint32_t hash_grid_3i(int32_t p_x, int32_t p_y, int32_t p_z) {
+	uint64_t k = (uint64_t)(uint32_t)p_x | ((uint64_t)(uint32_t)p_y << 32);
+	// Multiplying by an odd constant spreads z over the whole key.
+	k ^= (uint64_t)(uint32_t)p_z * 0x9E3779B97F4A7C15ULL;
+	return hash_one_uint64(k);
+}
+
 #define HASH_MURMUR3_SEED 0x7F07C65
 // Murmurhash3 32-bit version.
 // All MurmurHash versions are public domain software, and the author disclaims all copyright to their code.
@@ -334,23 +348,13 @@ struct HashMapHasherDefault {
 	static _FORCE_INLINE_ uint32_t hash(const uint8_t p_int) { return hash_fmix32(p_int); }
 	static _FORCE_INLINE_ uint32_t hash(const int8_t p_int) { return hash_fmix32(p_int); }
 
-	static _FORCE_INLINE_ uint32_t hash(const Vector2i &p_vec) {
-		uint32_t h = hash_murmur3_one_32(p_vec.x);
-		h = hash_murmur3_one_32(p_vec.y, h);
-		return hash_fmix32(h);
-	}
-	static _FORCE_INLINE_ uint32_t hash(const Vector3i &p_vec) {
-		uint32_t h = hash_murmur3_one_32(p_vec.x);
-		h = hash_murmur3_one_32(p_vec.y, h);
-		h = hash_murmur3_one_32(p_vec.z, h);
-		return hash_fmix32(h);
-	}
+	static _FORCE_INLINE_ uint32_t hash(const Vector2i &p_vec) { return hash_grid_2i(p_vec.x, p_vec.y); }
+	static _FORCE_INLINE_ uint32_t hash(const Vector3i &p_vec) { return hash_grid_3i(p_vec.x, p_vec.y, p_vec.z); }
 	static _FORCE_INLINE_ uint32_t hash(const Vector4i &p_vec) {
-		uint32_t h = hash_murmur3_one_32(p_vec.x);
-		h = hash_murmur3_one_32(p_vec.y, h);
-		h = hash_murmur3_one_32(p_vec.z, h);
-		h = hash_murmur3_one_32(p_vec.w, h);
-		return hash_fmix32(h);
+		uint64_t k = (uint64_t)(uint32_t)p_vec.z | ((uint64_t)(uint32_t)p_vec.w << 32);
+		k *= 0x9E3779B97F4A7C15ULL;
+		k ^= (uint64_t)(uint32_t)p_vec.x | ((uint64_t)(uint32_t)p_vec.y << 32);
+		return hash_one_uint64(k);
 	}
 	static _FORCE_INLINE_ uint32_t hash(const Vector2 &p_vec) {
 		uint32_t h = hash_murmur3_one_real(p_vec.x);
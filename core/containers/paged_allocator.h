@@ -62,7 +62,7 @@ public:
 			available_pool[pages_used] = (T **)memalloc(sizeof(T *) * page_size);
 
 			for (uint32_t i = 0; i < page_size; i++) {
-				available_pool[0][i] = &page_pool[pages_used][i];
+				available_pool[pages_used][i] = &page_pool[pages_used][i];
 			}
 			allocs_available += page_size;
 		}
@@ -82,10 +82,10 @@ public:
 		}
 		p_mem->~T();
 		available_pool[allocs_available >> page_shift][allocs_available & page_mask] = p_mem;
+		allocs_available++;
 		if (thread_safe) {
 			spin_lock.unlock();
 		}
-		allocs_available++;
 	}
 
 	void reset(bool p_allow_unfreed = false) {
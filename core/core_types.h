@@ -38,19 +38,26 @@
 #include "basis.h"
 #include "color.h"
 #include "dictionary.h"
+#include "json_reader.h"
+#include "json_writer.h"
 #include "node_path.h"
 #include "plane.h"
 #include "pool_arrays.h"
+#include "position3.h"
 #include "projection.h"
 #include "quaternion.h"
 #include "rect2.h"
 #include "rect2i.h"
 #include "rid.h"
+#include "signal_handle.h"
+#include "string_builder.h"
 #include "string_name.h"
+#include "string_view.h"
 #include "transform.h"
 #include "transform_2d.h"
 #include "ustring.h"
 #include "variant.h"
+#include "variant_serializer.h"
 #include "vector2.h"
 #include "vector2i.h"
 #include "vector3.h"
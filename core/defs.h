@@ -94,6 +94,14 @@ enum Error {
 
 typedef float real_t;
 
+// real_t has to stay float, as it is shared with the engine through the math types.
+// Mixed precision builds only widen world positions that are kept on the native side, see Position3.
+#ifdef PANDEMONIUM_MIXED_PRECISION
+typedef double position_t;
+#else
+typedef float position_t;
+#endif
+
 // This epsilon should match the one used by Pandemonium for consistency.
 // Using `f` when `real_t` is float.
 #define CMP_EPSILON 0.00001f
@@ -101,6 +109,8 @@ typedef float real_t;
 
 #define Math_PI 3.1415926535897932384626433833
 #define Math_TAU 6.2831853071795864769252867666
+#define Math_SQRT2 1.4142135623730950488016887242
+#define Math_LOG2E 1.4426950408889634073599246810
 #define Math_INF INFINITY
 #define Math_NAN NAN
 
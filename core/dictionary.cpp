@@ -76,6 +76,11 @@ Array Dictionary::keys() const {
 	return Array(a);
 }
 
+const Variant *Dictionary::next(const Variant *p_key) const {
+	pandemonium_variant *v = Pandemonium::api->pandemonium_dictionary_next(&_pandemonium_dictionary, (const pandemonium_variant *)p_key);
+	return reinterpret_cast<const Variant *>(v);
+}
+
 Variant &Dictionary::operator[](const Variant &key) {
 	pandemonium_variant *v = Pandemonium::api->pandemonium_dictionary_operator_index(&_pandemonium_dictionary, (pandemonium_variant *)&key);
 	return *reinterpret_cast<Variant *>(v);
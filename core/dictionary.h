@@ -36,6 +36,8 @@
 
 #include <gdn/dictionary.h>
 
+#include <utility>
+
 class Variant;
 
 class Dictionary {
@@ -47,13 +49,60 @@ class Dictionary {
 	}
 
 public:
+	// One entry, as seen while iterating. The value is looked up when asked for.
+	class Element {
+		friend class Dictionary;
+
+		const Dictionary *_dictionary;
+		const Variant *_key;
+
+	public:
+		_FORCE_INLINE_ const Variant &key() const { return *_key; }
+		_FORCE_INLINE_ Variant &value() const { return const_cast<Dictionary &>(*_dictionary)[*_key]; }
+
+#if __cplusplus >= 201703L
+		// Allows `for (auto &[key, value] : dictionary)`.
+		template <size_t I>
+		decltype(auto) get() const {
+			if constexpr (I == 0) {
+				return key();
+			} else {
+				return value();
+			}
+		}
+#endif
+	};
+
+	// Walks the entries in insertion order through the engine's next(),
+	// without building the keys() and values() arrays. Adding or erasing
+	// entries while iterating invalidates the iterator.
+	class Iterator {
+		friend class Dictionary;
+
+		Element _element;
+
+	public:
+		_FORCE_INLINE_ const Element &operator*() const { return _element; }
+		_FORCE_INLINE_ const Element *operator->() const { return &_element; }
+
+		_FORCE_INLINE_ Iterator &operator++() {
+			_element._key = _element._dictionary->next(_element._key);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &p_it) const { return _element._key == p_it._element._key; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &p_it) const { return _element._key != p_it._element._key; }
+	};
+
 	Dictionary();
 	Dictionary(const Dictionary &other);
 	Dictionary &operator=(const Dictionary &other);
 
 	template <class... Args>
-	static Dictionary make(Args... args) {
-		return helpers::add_all(Dictionary(), args...);
+	static Dictionary make(const Args &...args) {
+		Dictionary dictionary;
+		helpers::add_all(dictionary, args...);
+		return dictionary;
 	}
 
 	void clear();
@@ -70,6 +119,22 @@ public:
 
 	Array keys() const;
 
+	// Key that follows p_key, the first key for nullptr, or nullptr at the end.
+	const Variant *next(const Variant *p_key = nullptr) const;
+
+	_FORCE_INLINE_ Iterator begin() const {
+		Iterator it;
+		it._element._dictionary = this;
+		it._element._key = next();
+		return it;
+	}
+	_FORCE_INLINE_ Iterator end() const {
+		Iterator it;
+		it._element._dictionary = this;
+		it._element._key = nullptr;
+		return it;
+	}
+
 	Variant &operator[](const Variant &key);
 
 	const Variant &operator[](const Variant &key) const;
@@ -83,4 +148,19 @@ public:
 	~Dictionary();
 };
 
+#if __cplusplus >= 201703L
+namespace std {
+template <>
+struct tuple_size<Dictionary::Element> : integral_constant<size_t, 2> {};
+template <>
+struct tuple_element<0, Dictionary::Element> {
+	typedef const Variant &type;
+};
+template <>
+struct tuple_element<1, Dictionary::Element> {
+	typedef Variant &type;
+};
+} // namespace std
+#endif
+
 #endif // DICTIONARY_H
@@ -0,0 +1,62 @@
+/*************************************************************************/
+/*  instance_pool.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "instance_pool.h"
+
+#include "os/spin_lock.h"
+
+static SpinLock instance_pool_lock;
+static InstancePoolStats *instance_pool_list = nullptr;
+
+void InstancePoolStats::_register() {
+	instance_pool_lock.lock();
+	_next = instance_pool_list;
+	instance_pool_list = this;
+	instance_pool_lock.unlock();
+}
+
+void InstancePoolStats::_unregister() {
+	instance_pool_lock.lock();
+
+	InstancePoolStats **link = &instance_pool_list;
+	while (*link && *link != this) {
+		link = &(*link)->_next;
+	}
+	if (*link) {
+		*link = _next;
+	}
+	_next = nullptr;
+
+	instance_pool_lock.unlock();
+}
+
+const InstancePoolStats *InstancePoolStats::get_first() {
+	return instance_pool_list;
+}
@@ -0,0 +1,248 @@
+/*************************************************************************/
+/*  instance_pool.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef INSTANCE_POOL_H
+#define INSTANCE_POOL_H
+
+#include "defs.h"
+
+#include "core/containers/paged_allocator.h"
+#include "core/os/memory.h"
+#include "core/os/spin_lock.h"
+
+#include <atomic>
+
+// Number of objects currently allocated from a pool, and the most there
+// have been at once. Every pool is listed from get_first(), to be
+// inspected when tuning page sizes or looking for leaks.
+class InstancePoolStats {
+	const char *_name;
+	std::atomic<uint32_t> _live;
+	std::atomic<uint32_t> _peak;
+	InstancePoolStats *_next;
+
+	template <class T>
+	friend class InstancePool;
+	template <class T>
+	friend class LockFreeInstancePool;
+
+	_FORCE_INLINE_ void _on_alloc() {
+		const uint32_t live = _live.fetch_add(1, std::memory_order_relaxed) + 1;
+		uint32_t peak = _peak.load(std::memory_order_relaxed);
+		while (live > peak && !_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+		}
+	}
+
+	_FORCE_INLINE_ void _on_free() {
+		_live.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void _register();
+	void _unregister();
+
+public:
+	_FORCE_INLINE_ const char *get_name() const { return _name; }
+	_FORCE_INLINE_ uint32_t get_live() const { return _live.load(std::memory_order_relaxed); }
+	_FORCE_INLINE_ uint32_t get_peak() const { return _peak.load(std::memory_order_relaxed); }
+	_FORCE_INLINE_ const InstancePoolStats *get_next() const { return _next; }
+
+	static const InstancePoolStats *get_first();
+
+	InstancePoolStats(const char *p_name) :
+			_name(p_name),
+			_live(0),
+			_peak(0),
+			_next(nullptr) {}
+};
+
+// Thread safe pool handing out T from pages of p_page_size objects, so
+// objects that are created and freed all the time reuse the same memory
+// instead of going through the global heap.
+template <class T>
+class InstancePool {
+	PagedAllocator<T, true> _allocator;
+	InstancePoolStats _stats;
+
+	InstancePool(const InstancePool &p_from);
+	InstancePool &operator=(const InstancePool &p_from);
+
+public:
+	_FORCE_INLINE_ T *alloc() {
+		T *instance = _allocator.alloc();
+		_stats._on_alloc();
+		return instance;
+	}
+
+	_FORCE_INLINE_ void free(T *p_instance) {
+		_allocator.free(p_instance);
+		_stats._on_free();
+	}
+
+	_FORCE_INLINE_ const InstancePoolStats &get_stats() const { return _stats; }
+
+	InstancePool(const char *p_name, uint32_t p_page_size) :
+			_allocator(p_page_size),
+			_stats(p_name) {
+		_stats._register();
+	}
+
+	~InstancePool() {
+		_stats._unregister();
+	}
+};
+
+// Same as InstancePool, but alloc() and free() take no lock. The free objects
+// form a stack whose head is swapped with a compare-and-swap, tagged with a
+// counter so a head that was popped and pushed back in between is noticed.
+// Only adding a page locks. Pages are kept until the pool is destroyed, so a
+// thread that loses a race never reads freed memory.
+template <class T>
+class LockFreeInstancePool {
+	struct Slot {
+		alignas(T) uint8_t storage[sizeof(T)];
+		uint32_t index;
+		std::atomic<uint32_t> next;
+	};
+
+	static const uint32_t NONE = 0xFFFFFFFF;
+	static const uint32_t MAX_PAGES = 4096;
+
+	// Tag in the high half, index of the first free slot in the low half.
+	std::atomic<uint64_t> _head;
+	std::atomic<Slot *> _pages[MAX_PAGES];
+	uint32_t _page_count;
+	uint32_t _page_shift;
+	uint32_t _page_mask;
+	SpinLock _grow_lock;
+	InstancePoolStats _stats;
+
+	LockFreeInstancePool(const LockFreeInstancePool &p_from);
+	LockFreeInstancePool &operator=(const LockFreeInstancePool &p_from);
+
+	_FORCE_INLINE_ Slot *_get_slot(uint32_t p_index) const {
+		return _pages[p_index >> _page_shift].load(std::memory_order_acquire) + (p_index & _page_mask);
+	}
+
+	_FORCE_INLINE_ static uint64_t _make_head(uint64_t p_previous, uint32_t p_index) {
+		return (((p_previous >> 32) + 1) << 32) | p_index;
+	}
+
+	bool _grow() {
+		_grow_lock.lock();
+
+		// Another thread may have added a page, or objects were freed meanwhile.
+		if ((uint32_t)_head.load(std::memory_order_acquire) != NONE) {
+			_grow_lock.unlock();
+			return true;
+		}
+		if (unlikely(_page_count == MAX_PAGES)) {
+			_grow_lock.unlock();
+			ERR_PRINT("Out of pages in LockFreeInstancePool.");
+			return false;
+		}
+
+		const uint32_t page_size = _page_mask + 1;
+		const uint32_t first = _page_count << _page_shift;
+
+		Slot *page = (Slot *)memalloc(sizeof(Slot) * page_size);
+		for (uint32_t i = 0; i < page_size; i++) {
+			page[i].index = first + i;
+			memnew_placement(&page[i].next, std::atomic<uint32_t>(first + i + 1));
+		}
+		_pages[_page_count].store(page, std::memory_order_release);
+		_page_count++;
+
+		Slot *last = &page[page_size - 1];
+		uint64_t head = _head.load(std::memory_order_relaxed);
+		do {
+			last->next.store((uint32_t)head, std::memory_order_relaxed);
+		} while (!_head.compare_exchange_weak(head, _make_head(head, first), std::memory_order_release, std::memory_order_relaxed));
+
+		_grow_lock.unlock();
+		return true;
+	}
+
+public:
+	T *alloc() {
+		uint64_t head = _head.load(std::memory_order_acquire);
+		while (true) {
+			const uint32_t index = (uint32_t)head;
+			if (unlikely(index == NONE)) {
+				if (!_grow()) {
+					return nullptr;
+				}
+				head = _head.load(std::memory_order_acquire);
+				continue;
+			}
+
+			Slot *slot = _get_slot(index);
+			const uint32_t next = slot->next.load(std::memory_order_relaxed);
+			if (_head.compare_exchange_weak(head, _make_head(head, next), std::memory_order_acquire, std::memory_order_acquire)) {
+				_stats._on_alloc();
+				return memnew_placement(slot->storage, T);
+			}
+		}
+	}
+
+	void free(T *p_instance) {
+		p_instance->~T();
+		_stats._on_free();
+
+		Slot *slot = (Slot *)p_instance;
+		uint64_t head = _head.load(std::memory_order_relaxed);
+		do {
+			slot->next.store((uint32_t)head, std::memory_order_relaxed);
+		} while (!_head.compare_exchange_weak(head, _make_head(head, slot->index), std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	_FORCE_INLINE_ const InstancePoolStats &get_stats() const { return _stats; }
+
+	LockFreeInstancePool(const char *p_name, uint32_t p_page_size) :
+			_head(NONE),
+			_page_count(0),
+			_stats(p_name) {
+		const uint32_t page_size = nearest_power_of_2_templated(MAX(p_page_size, 2u));
+		_page_shift = get_shift_from_power_of_2(page_size);
+		_page_mask = page_size - 1;
+		for (uint32_t i = 0; i < MAX_PAGES; i++) {
+			_pages[i].store(nullptr, std::memory_order_relaxed);
+		}
+		_stats._register();
+	}
+
+	~LockFreeInstancePool() {
+		_stats._unregister();
+		for (uint32_t i = 0; i < _page_count; i++) {
+			memfree(_pages[i].load(std::memory_order_relaxed));
+		}
+	}
+};
+
+#endif // INSTANCE_POOL_H
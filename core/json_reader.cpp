@@ -0,0 +1,814 @@
+/*************************************************************************/
+/*  json_reader.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "json_reader.h"
+
+#include "array.h"
+#include "dictionary.h"
+#include "os/memory.h"
+#include "pool_arrays.h"
+#include "ustring.h"
+#include "variant.h"
+
+#include "core/containers/vector.h"
+
+#include <locale.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON_READER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static _FORCE_INLINE_ int _lowest_bit(uint32_t p_mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, p_mask);
+	return (int)index;
+#else
+	return __builtin_ctz(p_mask);
+#endif
+}
+
+static _FORCE_INLINE_ bool _is_whitespace(char p_char) {
+	return p_char == ' ' || p_char == '\n' || p_char == '\r' || p_char == '\t';
+}
+
+static _FORCE_INLINE_ bool _is_digit(char p_char) {
+	return p_char >= '0' && p_char <= '9';
+}
+
+static int _hex_digit(char p_char) {
+	if (p_char >= '0' && p_char <= '9') {
+		return p_char - '0';
+	}
+	if (p_char >= 'a' && p_char <= 'f') {
+		return p_char - 'a' + 10;
+	}
+	if (p_char >= 'A' && p_char <= 'F') {
+		return p_char - 'A' + 10;
+	}
+	return -1;
+}
+
+static int _encode_utf8(char32_t p_char, char *r_dst) {
+	if (p_char < 0x80) {
+		r_dst[0] = (char)p_char;
+		return 1;
+	} else if (p_char < 0x800) {
+		r_dst[0] = (char)(0xC0 | (p_char >> 6));
+		r_dst[1] = (char)(0x80 | (p_char & 0x3F));
+		return 2;
+	} else if (p_char < 0x10000) {
+		r_dst[0] = (char)(0xE0 | (p_char >> 12));
+		r_dst[1] = (char)(0x80 | ((p_char >> 6) & 0x3F));
+		r_dst[2] = (char)(0x80 | (p_char & 0x3F));
+		return 3;
+	} else {
+		r_dst[0] = (char)(0xF0 | (p_char >> 18));
+		r_dst[1] = (char)(0x80 | ((p_char >> 12) & 0x3F));
+		r_dst[2] = (char)(0x80 | ((p_char >> 6) & 0x3F));
+		r_dst[3] = (char)(0x80 | (p_char & 0x3F));
+		return 4;
+	}
+}
+
+// Powers of ten that are exact in a double.
+static const double _exact_pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+	1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* JSONReader */
+
+Error JSONReader::_set_error(const char *p_at, const char *p_message) {
+	_error = ERR_PARSE_ERROR;
+	_error_message = p_message;
+
+	// Positions are only needed on failure, count them now rather than while parsing.
+	_error_line = 1;
+	_error_column = 1;
+	for (const char *c = _begin; c < p_at && c < _end; c++) {
+		if (*c == '\n') {
+			_error_line++;
+			_error_column = 1;
+		} else {
+			_error_column++;
+		}
+	}
+
+	return _error;
+}
+
+void JSONReader::_skip_whitespace() {
+#ifdef JSON_READER_SSE2
+	// Indented documents have long runs of whitespace, skip them 16 bytes at a time.
+	if (_src + 16 <= _end && _is_whitespace(*_src)) {
+		const __m128i space = _mm_set1_epi8(' ');
+		const __m128i newline = _mm_set1_epi8('\n');
+		const __m128i carriage_return = _mm_set1_epi8('\r');
+		const __m128i tab = _mm_set1_epi8('\t');
+
+		while (_src + 16 <= _end) {
+			const __m128i chunk = _mm_loadu_si128((const __m128i *)_src);
+			const __m128i ws = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, newline)),
+					_mm_or_si128(_mm_cmpeq_epi8(chunk, carriage_return), _mm_cmpeq_epi8(chunk, tab)));
+			const uint32_t other = ~(uint32_t)_mm_movemask_epi8(ws) & 0xFFFF;
+			if (other) {
+				_src += _lowest_bit(other);
+				return;
+			}
+			_src += 16;
+		}
+	}
+#endif
+
+	while (_src < _end && _is_whitespace(*_src)) {
+		_src++;
+	}
+}
+
+char *JSONReader::_scratch_reserve(int p_length) {
+	if (unlikely(p_length > _scratch_capacity)) {
+		int capacity = MAX(_scratch_capacity, 256);
+		while (capacity < p_length) {
+			capacity <<= 1;
+		}
+
+		char *scratch = (char *)memrealloc(_scratch, capacity);
+		ERR_FAIL_NULL_V(scratch, nullptr);
+
+		_scratch = scratch;
+		_scratch_capacity = capacity;
+	}
+
+	return _scratch;
+}
+
+bool JSONReader::_parse_literal(const char *p_literal, int p_length) {
+	if (_end - _src < p_length || memcmp(_src, p_literal, p_length) != 0) {
+		_set_error(_src, "Invalid literal");
+		return false;
+	}
+
+	_src += p_length;
+	return true;
+}
+
+bool JSONReader::_parse_string(Utf8StringView &r_string) {
+	const char *from = ++_src;
+
+	// Find the end of the string, or the first escape. Most strings don't
+	// have any, and are returned as a view into the input.
+	const char *c = from;
+
+#ifdef JSON_READER_SSE2
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i control = _mm_set1_epi8(0x1F);
+
+	while (c + 16 <= _end) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i *)c);
+		const __m128i special = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+				_mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+		const uint32_t mask = (uint32_t)_mm_movemask_epi8(special);
+		if (mask) {
+			c += _lowest_bit(mask);
+			break;
+		}
+		c += 16;
+	}
+#endif
+
+	while (c < _end && *c != '"' && *c != '\\' && (uint8_t)*c >= 0x20) {
+		c++;
+	}
+
+	if (c >= _end) {
+		_set_error(from - 1, "Unterminated string");
+		return false;
+	}
+
+	if (*c == '"') {
+		r_string = Utf8StringView(from, c - from);
+		_src = c + 1;
+		return true;
+	}
+
+	if (*c != '\\') {
+		_set_error(c, "Control character in string");
+		return false;
+	}
+
+	// Escaped string, unescape into the scratch buffer. The output is never
+	// longer than the input it comes from.
+	int length = c - from;
+	char *dst = _scratch_reserve(length + 4);
+	ERR_FAIL_NULL_V(dst, false);
+	memcpy(dst, from, length);
+
+	while (true) {
+		if (c >= _end) {
+			_set_error(from - 1, "Unterminated string");
+			return false;
+		}
+
+		const char ch = *c;
+
+		if (ch == '"') {
+			break;
+		}
+
+		if ((uint8_t)ch < 0x20) {
+			_set_error(c, "Control character in string");
+			return false;
+		}
+
+		dst = _scratch_reserve(length + 4);
+		ERR_FAIL_NULL_V(dst, false);
+
+		if (ch != '\\') {
+			dst[length++] = ch;
+			c++;
+			continue;
+		}
+
+		if (c + 1 >= _end) {
+			_set_error(from - 1, "Unterminated string");
+			return false;
+		}
+
+		switch (c[1]) {
+			case '"':
+			case '\\':
+			case '/':
+				dst[length++] = c[1];
+				break;
+			case 'b':
+				dst[length++] = '\b';
+				break;
+			case 'f':
+				dst[length++] = '\f';
+				break;
+			case 'n':
+				dst[length++] = '\n';
+				break;
+			case 'r':
+				dst[length++] = '\r';
+				break;
+			case 't':
+				dst[length++] = '\t';
+				break;
+			case 'u': {
+				char32_t codepoint = 0;
+				for (int i = 0; i < 4; i++) {
+					const int digit = (c + 2 + i < _end) ? _hex_digit(c[2 + i]) : -1;
+					if (digit < 0) {
+						_set_error(c, "Invalid unicode escape");
+						return false;
+					}
+					codepoint = (codepoint << 4) | digit;
+				}
+				c += 4;
+
+				if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+					// Surrogate pairs come as two escapes.
+					char32_t low = 0;
+					bool has_low = _end - c >= 8 && c[2] == '\\' && c[3] == 'u';
+					for (int i = 0; has_low && i < 4; i++) {
+						const int digit = _hex_digit(c[4 + i]);
+						has_low = digit >= 0;
+						low = (low << 4) | digit;
+					}
+
+					if (has_low && low >= 0xDC00 && low <= 0xDFFF) {
+						codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+						c += 6;
+					} else {
+						codepoint = 0xFFFD;
+					}
+				} else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+					codepoint = 0xFFFD;
+				}
+
+				length += _encode_utf8(codepoint, dst + length);
+			} break;
+			default:
+				_set_error(c, "Invalid escape sequence");
+				return false;
+		}
+
+		c += 2;
+	}
+
+	r_string = Utf8StringView(_scratch, length);
+	_src = c + 1;
+	return true;
+}
+
+bool JSONReader::_parse_number(JSONHandler &p_handler) {
+	const char *from = _src;
+	const char *c = _src;
+
+	const bool negative = *c == '-';
+	if (negative) {
+		c++;
+	}
+
+	if (c >= _end || !_is_digit(*c)) {
+		_set_error(from, "Invalid number");
+		return false;
+	}
+
+	// Up to 19 significant digits fit in the mantissa, later ones only
+	// scale it, and make the fast paths below give up.
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	bool truncated = false;
+
+	if (*c == '0') {
+		c++;
+	} else {
+		for (; c < _end && _is_digit(*c); c++) {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (*c - '0');
+				digits++;
+			} else {
+				exponent++;
+				truncated = true;
+			}
+		}
+	}
+
+	bool integer = true;
+
+	if (c < _end && *c == '.') {
+		integer = false;
+		c++;
+		if (c >= _end || !_is_digit(*c)) {
+			_set_error(from, "Invalid number");
+			return false;
+		}
+
+		for (; c < _end && _is_digit(*c); c++) {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (*c - '0');
+				digits++;
+				exponent--;
+			} else {
+				truncated = true;
+			}
+		}
+	}
+
+	if (c < _end && (*c == 'e' || *c == 'E')) {
+		integer = false;
+		c++;
+
+		bool exponent_negative = false;
+		if (c < _end && (*c == '+' || *c == '-')) {
+			exponent_negative = *c == '-';
+			c++;
+		}
+
+		if (c >= _end || !_is_digit(*c)) {
+			_set_error(from, "Invalid number");
+			return false;
+		}
+
+		int value = 0;
+		for (; c < _end && _is_digit(*c); c++) {
+			if (value < 100000) {
+				value = value * 10 + (*c - '0');
+			}
+		}
+		exponent += exponent_negative ? -value : value;
+	}
+
+	_src = c;
+
+	// -0 has no integer representation, it stays a REAL to keep its sign.
+	if (integer && !truncated && !(negative && mantissa == 0)) {
+		if (!negative && mantissa <= (uint64_t)INT64_MAX) {
+			return p_handler.int_value((int64_t)mantissa);
+		}
+		if (negative && mantissa <= (uint64_t)INT64_MAX + 1) {
+			return p_handler.int_value((int64_t)(0 - mantissa));
+		}
+	}
+
+	// Exact when both the mantissa and the power of ten are exact doubles.
+	if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+		double value = (double)mantissa;
+		if (exponent < 0) {
+			value /= _exact_pow10[-exponent];
+		} else {
+			value *= _exact_pow10[exponent];
+		}
+		return p_handler.real_value(negative ? -value : value);
+	}
+
+	// Everything else goes through strtod, on a terminated copy of the token.
+	// strtod reads the decimal separator of the current locale, so the
+	// token's '.' (there is at most one) is replaced with it.
+	const char *point = localeconv()->decimal_point;
+	const int point_length = strlen(point);
+	const int length = c - from;
+	char *buffer = _scratch_reserve(length + point_length);
+	ERR_FAIL_NULL_V(buffer, false);
+
+	int size = 0;
+	for (const char *p = from; p < c; p++) {
+		if (*p == '.') {
+			memcpy(buffer + size, point, point_length);
+			size += point_length;
+		} else {
+			buffer[size++] = *p;
+		}
+	}
+	buffer[size] = 0;
+
+	return p_handler.real_value(strtod(buffer, nullptr));
+}
+
+Error JSONReader::parse(const Utf8StringView &p_text, JSONHandler &p_handler) {
+	_begin = p_text.ptr();
+	_src = _begin;
+	_end = _begin + p_text.length();
+
+	_error = OK;
+	_error_message = "";
+	_error_line = 0;
+	_error_column = 0;
+
+	// Open containers, as a bitset of objects, and the number of values
+	// already found in each of them.
+	uint8_t objects[MAX_DEPTH / 8];
+	int counts[MAX_DEPTH];
+	int depth = 0;
+
+#define JSON_IS_OBJECT(m_depth) ((objects[(m_depth) >> 3] >> ((m_depth)&7)) & 1)
+#define JSON_CALL(m_call)      \
+	if (unlikely(!(m_call))) { \
+		if (_error == OK) {    \
+			_error = ERR_SKIP; \
+		}                      \
+		return _error;         \
+	}
+
+	while (true) {
+		// Inside objects, every value comes after its key.
+		if (depth > 0 && JSON_IS_OBJECT(depth - 1)) {
+			_skip_whitespace();
+			if (_src >= _end || *_src != '"') {
+				return _set_error(_src, "Expected string key");
+			}
+
+			Utf8StringView key;
+			if (!_parse_string(key)) {
+				return _error;
+			}
+			JSON_CALL(p_handler.key(key));
+
+			_skip_whitespace();
+			if (_src >= _end || *_src != ':') {
+				return _set_error(_src, "Expected ':'");
+			}
+			_src++;
+		}
+
+		_skip_whitespace();
+		if (_src >= _end) {
+			return _set_error(_src, "Unexpected end of input");
+		}
+
+		switch (*_src) {
+			case '{':
+			case '[': {
+				const bool object = *_src == '{';
+				_src++;
+				JSON_CALL(object ? p_handler.begin_object() : p_handler.begin_array());
+
+				_skip_whitespace();
+				if (_src < _end && *_src == (object ? '}' : ']')) {
+					_src++;
+					JSON_CALL(object ? p_handler.end_object(0) : p_handler.end_array(0));
+					break;
+				}
+
+				if (depth == MAX_DEPTH) {
+					return _set_error(_src, "Too many nested containers");
+				}
+
+				if (object) {
+					objects[depth >> 3] |= (1 << (depth & 7));
+				} else {
+					objects[depth >> 3] &= ~(1 << (depth & 7));
+				}
+				counts[depth] = 0;
+				depth++;
+				continue;
+			}
+			case '"': {
+				Utf8StringView string;
+				if (!_parse_string(string)) {
+					return _error;
+				}
+				JSON_CALL(p_handler.string_value(string));
+			} break;
+			case 't':
+				if (!_parse_literal("true", 4)) {
+					return _error;
+				}
+				JSON_CALL(p_handler.bool_value(true));
+				break;
+			case 'f':
+				if (!_parse_literal("false", 5)) {
+					return _error;
+				}
+				JSON_CALL(p_handler.bool_value(false));
+				break;
+			case 'n':
+				if (!_parse_literal("null", 4)) {
+					return _error;
+				}
+				JSON_CALL(p_handler.null_value());
+				break;
+			default:
+				if (*_src != '-' && !_is_digit(*_src)) {
+					return _set_error(_src, "Unexpected character");
+				}
+				JSON_CALL(_parse_number(p_handler));
+				break;
+		}
+
+		// A value is complete, close the containers it completes and move to the next one.
+		while (true) {
+			_skip_whitespace();
+
+			if (depth == 0) {
+				if (_src != _end) {
+					return _set_error(_src, "Unexpected data after the document");
+				}
+				return OK;
+			}
+
+			if (_src >= _end) {
+				return _set_error(_src, "Unexpected end of input");
+			}
+
+			const int top = depth - 1;
+			const bool object = JSON_IS_OBJECT(top);
+			counts[top]++;
+
+			if (*_src == ',') {
+				_src++;
+				break;
+			}
+
+			if (*_src != (object ? '}' : ']')) {
+				return _set_error(_src, object ? "Expected ',' or '}'" : "Expected ',' or ']'");
+			}
+
+			_src++;
+			depth--;
+			JSON_CALL(object ? p_handler.end_object(counts[top]) : p_handler.end_array(counts[top]));
+		}
+	}
+
+#undef JSON_CALL
+#undef JSON_IS_OBJECT
+}
+
+/* Variant builder */
+
+// Builds the Variant for a document from the bottom up. Values are kept in
+// a native stack until their container is closed, so each Array is created
+// at its final size and filled in place.
+class _JSONVariantBuilder : public JSONHandler {
+	enum {
+		KIND_INT = 1,
+		KIND_INT64 = 2,
+		KIND_REAL = 4,
+		KIND_STRING = 8,
+		KIND_OTHER = 16,
+	};
+
+	struct Frame {
+		int start;
+		int kinds;
+	};
+
+	Vector<Variant> _values;
+	Vector<Frame> _frames;
+	int _flags;
+
+	void _push(const Variant &p_value, int p_kind) {
+		const int size = _values.size();
+		_values.resize(size + 1);
+		_values.ptrw()[size] = p_value;
+
+		if (_frames.size()) {
+			_frames.ptrw()[_frames.size() - 1].kinds |= p_kind;
+		}
+	}
+
+	void _push_frame() {
+		Frame frame;
+		frame.start = _values.size();
+		frame.kinds = 0;
+		_frames.push_back(frame);
+	}
+
+	Frame _pop_frame() {
+		Frame frame = _frames[_frames.size() - 1];
+		_frames.resize(_frames.size() - 1);
+		return frame;
+	}
+
+	template <class P, class T>
+	Variant _make_pool(const Variant *p_values, int p_size) {
+		P pool;
+		pool.resize(p_size);
+
+		typename P::Write w = pool.write();
+		auto *dst = w.ptr();
+		for (int i = 0; i < p_size; i++) {
+			const T value = p_values[i];
+			dst[i] = value;
+		}
+
+		return pool;
+	}
+
+public:
+	Variant get_result() const {
+		return _values.size() ? _values[0] : Variant();
+	}
+
+	virtual bool null_value() {
+		_push(Variant(), KIND_OTHER);
+		return true;
+	}
+
+	virtual bool bool_value(bool p_value) {
+		_push(p_value, KIND_OTHER);
+		return true;
+	}
+
+	virtual bool int_value(int64_t p_value) {
+		if (!(_flags & JSONReader::PARSE_INTEGERS)) {
+			return real_value((double)p_value);
+		}
+
+		const bool fits = p_value >= INT32_MIN && p_value <= INT32_MAX;
+		_push(p_value, fits ? KIND_INT : KIND_INT64);
+		return true;
+	}
+
+	virtual bool real_value(double p_value) {
+		_push(p_value, KIND_REAL);
+		return true;
+	}
+
+	virtual bool string_value(const Utf8StringView &p_value) {
+		_push(p_value.to_string(), KIND_STRING);
+		return true;
+	}
+
+	virtual bool begin_object() {
+		_push_frame();
+		return true;
+	}
+
+	virtual bool key(const Utf8StringView &p_key) {
+		// Keys are stacked in front of their value, without affecting the container kinds.
+		const int size = _values.size();
+		_values.resize(size + 1);
+		_values.ptrw()[size] = p_key.to_string();
+		return true;
+	}
+
+	virtual bool end_object(int p_size) {
+		const Frame frame = _pop_frame();
+
+		Dictionary dictionary;
+		const Variant *src = _values.ptr() + frame.start;
+		for (int i = 0; i < p_size; i++) {
+			dictionary[src[i * 2]] = src[i * 2 + 1];
+		}
+
+		_values.resize(frame.start);
+		_push(dictionary, KIND_OTHER);
+		return true;
+	}
+
+	virtual bool begin_array() {
+		_push_frame();
+		return true;
+	}
+
+	virtual bool end_array(int p_size) {
+		const Frame frame = _pop_frame();
+		const Variant *src = _values.ptr() + frame.start;
+
+		Variant result;
+		if ((_flags & JSONReader::PARSE_POOL_ARRAYS) && p_size > 0 && frame.kinds == KIND_STRING) {
+			result = _make_pool<PoolStringArray, String>(src, p_size);
+		} else if ((_flags & JSONReader::PARSE_POOL_ARRAYS) && p_size > 0 && frame.kinds == KIND_INT) {
+			result = _make_pool<PoolIntArray, int>(src, p_size);
+		} else if ((_flags & JSONReader::PARSE_POOL_ARRAYS) && p_size > 0 && !(frame.kinds & ~(KIND_INT | KIND_INT64 | KIND_REAL))) {
+			result = _make_pool<PoolRealArray, real_t>(src, p_size);
+		} else {
+			Array array;
+			array.resize(p_size);
+			if (p_size > 0) {
+				// Array elements are contiguous, only the first one is looked up.
+				Variant *dst = &array[0];
+				for (int i = 0; i < p_size; i++) {
+					dst[i] = src[i];
+				}
+			}
+			result = array;
+		}
+
+		_values.resize(frame.start);
+		_push(result, KIND_OTHER);
+		return true;
+	}
+
+	_JSONVariantBuilder(int p_flags) :
+			_flags(p_flags) {}
+};
+
+Error JSONReader::parse(const Utf8StringView &p_text, Variant &r_result, int p_flags) {
+	_JSONVariantBuilder builder(p_flags);
+
+	const Error err = parse(p_text, builder);
+	if (err != OK) {
+		return err;
+	}
+
+	r_result = builder.get_result();
+	return OK;
+}
+
+Error JSONReader::parse(const String &p_text, Variant &r_result, int p_flags) {
+	// Error columns count UTF-8 bytes here, not characters.
+	SmallString utf8(p_text);
+	return parse(utf8.view(), r_result, p_flags);
+}
+
+JSONReader::JSONReader() :
+		_src(nullptr),
+		_end(nullptr),
+		_begin(nullptr),
+		_scratch(nullptr),
+		_scratch_capacity(0),
+		_error(OK),
+		_error_message(""),
+		_error_line(0),
+		_error_column(0) {
+}
+
+JSONReader::~JSONReader() {
+	if (_scratch) {
+		memfree(_scratch);
+	}
+}
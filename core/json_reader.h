@@ -0,0 +1,125 @@
+/*************************************************************************/
+/*  json_reader.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include "defs.h"
+
+#include "string_view.h"
+
+class String;
+class Variant;
+
+// Receives the contents of a JSON document from JSONReader as they are
+// parsed, without any Variant being created. Returning false from a
+// callback stops parsing, parse() then returns ERR_SKIP.
+// String views point into the input or into the reader's scratch buffer,
+// and are only valid until the callback returns.
+class JSONHandler {
+public:
+	virtual bool null_value() { return true; }
+	virtual bool bool_value(bool p_value) { return true; }
+	// Called for numbers without fraction or exponent that fit in 64 bits,
+	// except -0, which goes to real_value().
+	virtual bool int_value(int64_t p_value) { return real_value((double)p_value); }
+	virtual bool real_value(double p_value) { return true; }
+	virtual bool string_value(const Utf8StringView &p_value) { return true; }
+
+	virtual bool begin_object() { return true; }
+	virtual bool key(const Utf8StringView &p_key) { return true; }
+	virtual bool end_object(int p_size) { return true; }
+
+	virtual bool begin_array() { return true; }
+	virtual bool end_array(int p_size) { return true; }
+
+	virtual ~JSONHandler() {}
+};
+
+// Native JSON parser working on UTF-8 text (RFC 8259). The whole document is
+// parsed in a single pass, without recursion, either into a handler or into a
+// Variant built from the bottom up: arrays are created once at their final
+// size, and homogeneous arrays can become pool arrays.
+// A reader can be reused; it keeps its scratch buffer between documents.
+class JSONReader {
+public:
+	enum ParseFlags {
+		// Numbers without fraction or exponent become INT instead of REAL.
+		PARSE_INTEGERS = 1,
+		// Arrays only holding numbers become PoolRealArray (PoolIntArray with
+		// PARSE_INTEGERS, if every element fits), and arrays only holding
+		// strings become PoolStringArray.
+		PARSE_POOL_ARRAYS = 2,
+	};
+
+	enum {
+		MAX_DEPTH = 1024,
+	};
+
+private:
+	const char *_src;
+	const char *_end;
+	const char *_begin;
+
+	char *_scratch;
+	int _scratch_capacity;
+
+	Error _error;
+	const char *_error_message;
+	int _error_line;
+	int _error_column;
+
+	Error _set_error(const char *p_at, const char *p_message);
+
+	void _skip_whitespace();
+	bool _parse_string(Utf8StringView &r_string);
+	bool _parse_number(JSONHandler &p_handler);
+	bool _parse_literal(const char *p_literal, int p_length);
+	char *_scratch_reserve(int p_length);
+
+	JSONReader(const JSONReader &p_from);
+	JSONReader &operator=(const JSONReader &p_from);
+
+public:
+	Error parse(const Utf8StringView &p_text, JSONHandler &p_handler);
+	Error parse(const Utf8StringView &p_text, Variant &r_result, int p_flags = 0);
+	Error parse(const String &p_text, Variant &r_result, int p_flags = 0);
+
+	// Details about the last failed parse().
+	_FORCE_INLINE_ Error get_error() const { return _error; }
+	_FORCE_INLINE_ const char *get_error_message() const { return _error_message; }
+	_FORCE_INLINE_ int get_error_line() const { return _error_line; }
+	_FORCE_INLINE_ int get_error_column() const { return _error_column; }
+
+	JSONReader();
+	~JSONReader();
+};
+
+#endif // JSON_READER_H
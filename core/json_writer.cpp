@@ -0,0 +1,421 @@
+/*************************************************************************/
+/*  json_writer.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "json_writer.h"
+
+#include "array.h"
+#include "dictionary.h"
+#include "pool_arrays.h"
+#include "sorting.h"
+#include "ustring.h"
+#include "variant.h"
+
+#include "core/containers/vector.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON_WRITER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static _FORCE_INLINE_ int _lowest_bit(uint32_t p_mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, p_mask);
+	return (int)index;
+#else
+	return __builtin_ctz(p_mask);
+#endif
+}
+
+static _FORCE_INLINE_ bool _needs_escape(uint32_t p_char) {
+	return p_char == '"' || p_char == '\\' || p_char < 0x20;
+}
+
+static const char32_t *_hex_digits = U"0123456789abcdef";
+
+static void _append_escape(StringBuilder &r_sink, uint32_t p_char) {
+	r_sink.append('\\');
+
+	switch (p_char) {
+		case '"':
+			r_sink.append('"');
+			break;
+		case '\\':
+			r_sink.append('\\');
+			break;
+		case '\b':
+			r_sink.append('b');
+			break;
+		case '\f':
+			r_sink.append('f');
+			break;
+		case '\n':
+			r_sink.append('n');
+			break;
+		case '\r':
+			r_sink.append('r');
+			break;
+		case '\t':
+			r_sink.append('t');
+			break;
+		default:
+			r_sink.append('u');
+			r_sink.append('0');
+			r_sink.append('0');
+			r_sink.append(_hex_digits[(p_char >> 4) & 0xF]);
+			r_sink.append(_hex_digits[p_char & 0xF]);
+			break;
+	}
+}
+
+void JSONWriter::_write_escaped(const StringView &p_string) {
+	const char32_t *src = p_string.ptr();
+	const int len = p_string.length();
+
+	_sink.append('"');
+
+	// Copy the runs between characters that need escaping in one go.
+	int from = 0;
+	int i = 0;
+	while (true) {
+#ifdef JSON_WRITER_SSE2
+		const __m128i quote = _mm_set1_epi32('"');
+		const __m128i backslash = _mm_set1_epi32('\\');
+		const __m128i space = _mm_set1_epi32(0x20);
+
+		for (; i + 4 <= len; i += 4) {
+			const __m128i chunk = _mm_loadu_si128((const __m128i *)(src + i));
+			const __m128i special = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi32(chunk, quote), _mm_cmpeq_epi32(chunk, backslash)),
+					_mm_cmplt_epi32(chunk, space));
+			const uint32_t mask = (uint32_t)_mm_movemask_epi8(special);
+			if (mask) {
+				i += _lowest_bit(mask) >> 2;
+				break;
+			}
+		}
+#endif
+
+		while (i < len && !_needs_escape(src[i])) {
+			i++;
+		}
+
+		_sink.append(StringView(src + from, i - from));
+		if (i == len) {
+			break;
+		}
+
+		_append_escape(_sink, src[i]);
+		from = ++i;
+	}
+
+	_sink.append('"');
+}
+
+void JSONWriter::_write_escaped(const Utf8StringView &p_string) {
+	const char *src = p_string.ptr();
+	const int len = p_string.length();
+
+	_sink.append('"');
+
+	int from = 0;
+	for (int i = 0; i < len; i++) {
+		if (_needs_escape((uint8_t)src[i])) {
+			_sink.append(Utf8StringView(src + from, i - from));
+			_append_escape(_sink, (uint8_t)src[i]);
+			from = i + 1;
+		}
+	}
+	_sink.append(Utf8StringView(src + from, len - from));
+
+	_sink.append('"');
+}
+
+void JSONWriter::_write_indent(int p_depth) {
+	_sink.append('\n');
+	for (int i = 0; i < p_depth; i++) {
+		_sink.append(_indent);
+	}
+}
+
+void JSONWriter::_begin_value() {
+	if (_after_key) {
+		_after_key = false;
+		return;
+	}
+
+	if (_depth == 0) {
+		return;
+	}
+
+	if (_has_values[_depth - 1]) {
+		_sink.append(',');
+	}
+	_has_values[_depth - 1] = 1;
+
+	if (!_indent.empty()) {
+		_write_indent(_depth);
+	}
+}
+
+void JSONWriter::_begin_container(char32_t p_open) {
+	ERR_FAIL_COND_MSG(_depth >= MAX_DEPTH, "JSON containers are nested too deeply.");
+
+	_begin_value();
+	_sink.append(p_open);
+	_has_values[_depth++] = 0;
+}
+
+void JSONWriter::_end_container(char32_t p_close) {
+	ERR_FAIL_COND_MSG(_depth == 0, "No JSON container to close.");
+
+	_depth--;
+	if (_has_values[_depth] && !_indent.empty()) {
+		_write_indent(_depth);
+	}
+	_sink.append(p_close);
+}
+
+void JSONWriter::begin_object() {
+	_begin_container('{');
+}
+
+void JSONWriter::end_object() {
+	_end_container('}');
+}
+
+void JSONWriter::begin_array() {
+	_begin_container('[');
+}
+
+void JSONWriter::end_array() {
+	_end_container(']');
+}
+
+void JSONWriter::key(const StringView &p_key) {
+	_begin_value();
+	_write_escaped(p_key);
+	_sink.append(':');
+	if (!_indent.empty()) {
+		_sink.append(' ');
+	}
+	_after_key = true;
+}
+
+void JSONWriter::key(const Utf8StringView &p_key) {
+	_begin_value();
+	_write_escaped(p_key);
+	_sink.append(':');
+	if (!_indent.empty()) {
+		_sink.append(' ');
+	}
+	_after_key = true;
+}
+
+void JSONWriter::key(const String &p_key) {
+	key(StringView(p_key));
+}
+
+void JSONWriter::write_null() {
+	_begin_value();
+	_sink.append("null");
+}
+
+void JSONWriter::write_bool(bool p_value) {
+	_begin_value();
+	_sink.append(p_value ? "true" : "false");
+}
+
+void JSONWriter::write_int(int64_t p_value) {
+	_begin_value();
+	_sink.append_int(p_value);
+}
+
+void JSONWriter::write_real(double p_value) {
+	_begin_value();
+	_sink.append_float(p_value);
+}
+
+void JSONWriter::write_string(const StringView &p_value) {
+	_begin_value();
+	_write_escaped(p_value);
+}
+
+void JSONWriter::write_string(const Utf8StringView &p_value) {
+	_begin_value();
+	_write_escaped(p_value);
+}
+
+void JSONWriter::write_string(const String &p_value) {
+	write_string(StringView(p_value));
+}
+
+void JSONWriter::write(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::NIL: {
+			write_null();
+		} break;
+		case Variant::BOOL: {
+			write_bool(p_value);
+		} break;
+		case Variant::INT: {
+			write_int(p_value);
+		} break;
+		case Variant::REAL: {
+			write_real(p_value);
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			begin_object();
+
+			if (_sort_keys) {
+				// Keys are converted once, and sorted on their native text.
+				Vector<String> names;
+				Vector<StringView> views;
+				Vector<const Variant *> keys;
+				Vector<int> order;
+
+				for (const Variant *k = dictionary.next(); k; k = dictionary.next(k)) {
+					keys.push_back(k);
+					names.push_back(*k);
+				}
+
+				const int size = keys.size();
+				views.resize(size);
+				order.resize(size);
+				for (int i = 0; i < size; i++) {
+					views.ptrw()[i] = StringView(names[i]);
+					order.ptrw()[i] = i;
+				}
+
+				const StringView *v = views.ptr();
+				Sorting::sort_by(order.ptrw(), size, [v](int a, int b) { return v[a] < v[b]; });
+
+				for (int i = 0; i < size; i++) {
+					const int index = order[i];
+					key(views[index]);
+					write(dictionary[*keys[index]]);
+				}
+			} else {
+				for (const Dictionary::Element &E : dictionary) {
+					const String k = E.key();
+					key(k);
+					write(E.value());
+				}
+			}
+
+			end_object();
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			const int size = array.size();
+
+			begin_array();
+			if (size > 0) {
+				const Variant *src = &array[0];
+				for (int i = 0; i < size; i++) {
+					write(src[i]);
+				}
+			}
+			end_array();
+		} break;
+		case Variant::POOL_INT_ARRAY: {
+			const PoolIntArray pool = p_value;
+			const int size = pool.size();
+
+			begin_array();
+			if (size > 0) {
+				PoolIntArray::Read r = pool.read();
+				const int *src = r.ptr();
+				for (int i = 0; i < size; i++) {
+					write_int(src[i]);
+				}
+			}
+			end_array();
+		} break;
+		case Variant::POOL_REAL_ARRAY: {
+			const PoolRealArray pool = p_value;
+			const int size = pool.size();
+
+			begin_array();
+			if (size > 0) {
+				PoolRealArray::Read r = pool.read();
+				const real_t *src = r.ptr();
+				for (int i = 0; i < size; i++) {
+					write_real(src[i]);
+				}
+			}
+			end_array();
+		} break;
+		case Variant::POOL_STRING_ARRAY: {
+			const PoolStringArray pool = p_value;
+			const int size = pool.size();
+
+			begin_array();
+			if (size > 0) {
+				PoolStringArray::Read r = pool.read();
+				const String *src = r.ptr();
+				for (int i = 0; i < size; i++) {
+					write_string(src[i]);
+				}
+			}
+			end_array();
+		} break;
+		default: {
+			const String s = p_value;
+			write_string(s);
+		} break;
+	}
+}
+
+void JSONWriter::print(const Variant &p_value, StringBuilder &r_sink, const char *p_indent, bool p_sort_keys) {
+	JSONWriter writer(r_sink, p_indent, p_sort_keys);
+	writer.write(p_value);
+}
+
+String JSONWriter::print(const Variant &p_value, const String &p_indent, bool p_sort_keys) {
+	SmallString indent(p_indent);
+
+	StringBuilder sb;
+	print(p_value, sb, indent.ptr(), p_sort_keys);
+	return sb.as_string();
+}
+
+JSONWriter::JSONWriter(StringBuilder &r_sink, const char *p_indent, bool p_sort_keys) :
+		_sink(r_sink),
+		_indent(p_indent),
+		_sort_keys(p_sort_keys),
+		_depth(0),
+		_after_key(false) {
+}
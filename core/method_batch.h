@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  method_batch.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef METHOD_BATCH_H
+#define METHOD_BATCH_H
+
+#include <initializer_list>
+#include <type_traits>
+
+#include <gdnative_api_struct.gen.h>
+
+#include "core_types.h"
+#include "defs.h"
+#include "pandemonium_global.h"
+#include "wrapped.h"
+
+// Calls one engine method on many objects in a single loop of ptrcalls, the
+// method bind being resolved once. Arguments are read in place from the
+// caller's buffers, already in the ptrcall encoding the engine expects:
+// int64_t for integers, double for floats, and the math types and String as
+// they are. Objects are given as their pandemonium_object * (the _owner of a
+// wrapper, never the wrapper or a Ref), which is loaded from the buffer and
+// passed as the argument itself, as the generated __icalls.h does.
+//
+// Transforms for many spatials, with the method resolved on first use:
+//
+//	static MethodBatch set_global_transform("Spatial", "set_global_transform");
+//	set_global_transform.call(spatials.ptr(), spatials.size(), transforms.ptr());
+class MethodBatch {
+	const char *_class_name;
+	const char *_method_name;
+	pandemonium_method_bind *_method_bind;
+
+	static constexpr bool _all(std::initializer_list<bool> p_values) {
+		for (bool value : p_values) {
+			if (!value) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static constexpr bool _any(std::initializer_list<bool> p_values) {
+		for (bool value : p_values) {
+			if (value) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <class A, class... Ts>
+	static constexpr bool _is_one_of() {
+		return _any({ std::is_same<A, Ts>::value... });
+	}
+
+	template <class A>
+	static constexpr bool _is_ptrcall_arg() {
+		return _is_one_of<A, bool, int64_t, double, pandemonium_object *, String,
+				Vector2, Vector2i, Vector3, Vector3i, Vector4, Vector4i, Rect2, Rect2i, Plane, ::AABB,
+				Quaternion, Basis, Transform2D, Transform, Projection, Color>();
+	}
+
+	pandemonium_method_bind *_resolve();
+
+public:
+	static const int MAX_ARGS = 16;
+
+	_FORCE_INLINE_ pandemonium_method_bind *get_method_bind() {
+		if (unlikely(!_method_bind)) {
+			return _resolve();
+		}
+		return _method_bind;
+	}
+
+	// Calls the method on the p_count objects of p_owners. The arguments of the
+	// first call are at p_args plus each of the p_arg_count offsets, the ones of
+	// each following call p_stride bytes further. Bit j of p_object_args is set
+	// when argument j is a pandemonium_object *. When r_rets is given, the
+	// return values are written there, p_ret_stride bytes apart.
+	void ptrcall(pandemonium_object *const *p_owners, int p_count, const void *p_args, size_t p_stride, const uint32_t *p_arg_offsets, int p_arg_count, uint32_t p_object_args, void *r_rets = nullptr, size_t p_ret_stride = 0);
+
+	// Same, with one array of p_count values per argument, and the objects
+	// given as wrappers. Null objects are skipped.
+	template <class T, class... Args>
+	void call(T *const *p_objects, int p_count, const Args *...p_args) {
+		static_assert(sizeof...(Args) <= MAX_ARGS, "Too many arguments for a batched call.");
+		static_assert(std::is_base_of<_Wrapped, T>::value, "Objects must be wrappers of engine objects.");
+		static_assert(_all({ true, _is_ptrcall_arg<Args>()... }), "Batched arguments must be int64_t, double, bool, math types, String or pandemonium_object *.");
+		ERR_FAIL_COND(p_count > 0 && !p_objects);
+
+		pandemonium_method_bind *mb = get_method_bind();
+		ERR_FAIL_NULL(mb);
+
+		const uint8_t *cursors[sizeof...(Args) + 1] = { (const uint8_t *)p_args... };
+		const size_t sizes[sizeof...(Args) + 1] = { sizeof(Args)... };
+		const bool objects[sizeof...(Args) + 1] = { std::is_same<Args, pandemonium_object *>::value... };
+		const void *args[sizeof...(Args) + 1];
+
+		for (int i = 0; i < p_count; i++) {
+			const T *object = p_objects[i];
+			if (likely(object)) {
+				for (unsigned int j = 0; j < sizeof...(Args); j++) {
+					args[j] = objects[j] ? (const void *)*(pandemonium_object *const *)cursors[j] : (const void *)cursors[j];
+				}
+				Pandemonium::api->pandemonium_method_bind_ptrcall(mb, object->_owner, args, nullptr);
+			}
+
+			for (unsigned int j = 0; j < sizeof...(Args); j++) {
+				cursors[j] += sizes[j];
+			}
+		}
+	}
+
+	MethodBatch(const char *p_class_name, const char *p_method_name) :
+			_class_name(p_class_name),
+			_method_name(p_method_name),
+			_method_bind(nullptr) {}
+
+	explicit MethodBatch(pandemonium_method_bind *p_method_bind) :
+			_class_name(nullptr),
+			_method_name(nullptr),
+			_method_bind(p_method_bind) {}
+};
+
+#endif // METHOD_BATCH_H
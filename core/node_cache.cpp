@@ -0,0 +1,78 @@
+/*************************************************************************/
+/*  node_cache.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "node_cache.h"
+
+#include "gen/node.h"
+
+Node *NodeCache::get(const Node *p_base, const NodePath &p_path) {
+	ERR_FAIL_NULL_V(p_base, nullptr);
+
+	Entry *e = _cache.getptr(p_path);
+	if (e) {
+		// The instance id outlives the node, a freed node no longer maps back to its owner.
+		// Only the owner stored here is compared, the wrapper may be gone with the node.
+		if (likely(Pandemonium::api->pandemonium_instance_from_id(e->instance_id) == e->owner)) {
+			return e->node;
+		}
+		_cache.erase(p_path);
+	}
+
+	Node *node = p_base->get_node(p_path);
+	if (node) {
+		Entry entry;
+		entry.node = node;
+		entry.owner = node->_owner;
+		entry.instance_id = node->get_instance_id();
+		_cache.insert(p_path, entry);
+	}
+
+	return node;
+}
+
+void NodeCache::invalidate() {
+	_cache.clear();
+}
+
+void NodeCache::invalidate(const NodePath &p_path) {
+	_cache.erase(p_path);
+}
+
+void NodeCache::notification(int p_what) {
+	switch (p_what) {
+		case Node::NOTIFICATION_ENTER_TREE:
+		case Node::NOTIFICATION_EXIT_TREE:
+		case Node::NOTIFICATION_MOVED_IN_PARENT:
+			invalidate();
+			break;
+		default:
+			break;
+	}
+}
@@ -0,0 +1,78 @@
+/*************************************************************************/
+/*  node_cache.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NODE_CACHE_H
+#define NODE_CACHE_H
+
+#include "core/containers/hash_map.h"
+#include "node_path.h"
+#include "pandemonium.h"
+
+class Node;
+
+// Caches the nodes resolved by get_node() for a single base node.
+//
+// Entries remember the instance id of the node they point to, so a node that
+// was freed since the lookup is detected and resolved again instead of being
+// returned dangling. Moving or renaming nodes is not detected: the owner
+// should forward its _notification() to notification(), or call invalidate()
+// after restructuring the tree below it.
+//
+// Best combined with NPATH(), which avoids parsing the path on every call:
+//
+//     Label *label = _nodes.get<Label>(this, NPATH("HUD/Score"));
+class NodeCache {
+	struct Entry {
+		Node *node;
+		// Checked before touching node, whose wrapper is freed along with it.
+		pandemonium_object *owner;
+		int64_t instance_id;
+	};
+
+	HashMap<NodePath, Entry> _cache;
+
+public:
+	Node *get(const Node *p_base, const NodePath &p_path);
+
+	template <class T>
+	_FORCE_INLINE_ T *get(const Node *p_base, const NodePath &p_path) {
+		return Object::cast_to<T>(get(p_base, p_path));
+	}
+
+	void invalidate();
+	void invalidate(const NodePath &p_path);
+
+	// Drops the cache on notifications that can change what paths resolve to.
+	void notification(int p_what);
+
+	_FORCE_INLINE_ int size() const { return _cache.size(); }
+};
+
+#endif // NODE_CACHE_H
@@ -29,26 +29,34 @@
 /*************************************************************************/
 
 #include "node_path.h"
+#include "os/spin_lock.h"
 #include "pandemonium_global.h"
 #include "ustring.h"
 
 #include <gdn/node_path.h>
 
-NodePath::NodePath() {
+#include <new>
+#include <string.h>
+
+NodePath::NodePath() :
+		_hash(0) {
 	String from = "";
 	Pandemonium::api->pandemonium_node_path_new(&_node_path, (pandemonium_string *)&from);
 }
 
-NodePath::NodePath(const NodePath &other) {
-	String from = other;
-	Pandemonium::api->pandemonium_node_path_new(&_node_path, (pandemonium_string *)&from);
+// Copies share the parsed path, only converting to String and back used to re-parse it.
+NodePath::NodePath(const NodePath &other) :
+		_hash(other._hash.load(std::memory_order_relaxed)) {
+	Pandemonium::api->pandemonium_node_path_new_copy(&_node_path, &other._node_path);
 }
 
-NodePath::NodePath(const String &from) {
+NodePath::NodePath(const String &from) :
+		_hash(0) {
 	Pandemonium::api->pandemonium_node_path_new(&_node_path, (pandemonium_string *)&from);
 }
 
-NodePath::NodePath(const char *contents) {
+NodePath::NodePath(const char *contents) :
+		_hash(0) {
 	String from = contents;
 	Pandemonium::api->pandemonium_node_path_new(&_node_path, (pandemonium_string *)&from);
 }
@@ -89,7 +97,12 @@ String NodePath::get_concatenated_subnames() const {
 }
 
 uint32_t NodePath::hash() const {
-	return Pandemonium::api->pandemonium_node_path_hash(&_node_path);
+	uint32_t h = _hash.load(std::memory_order_relaxed);
+	if (h == 0) {
+		h = Pandemonium::api->pandemonium_node_path_hash(&_node_path);
+		_hash.store(h, std::memory_order_relaxed);
+	}
+	return h;
 }
 
 NodePath::operator String() const {
@@ -97,18 +110,73 @@ NodePath::operator String() const {
 	return String(str);
 }
 
-bool NodePath::operator==(const NodePath &other) {
+bool NodePath::operator==(const NodePath &other) const {
+	// Copies of the same path share their data, so identical handles are
+	// equal without asking the engine.
+	if (memcmp(&_node_path, &other._node_path, sizeof(pandemonium_node_path)) == 0) {
+		return true;
+	}
+	const uint32_t h = _hash.load(std::memory_order_relaxed);
+	const uint32_t other_h = other._hash.load(std::memory_order_relaxed);
+	if (h != 0 && other_h != 0 && h != other_h) {
+		return false;
+	}
 	return Pandemonium::api->pandemonium_node_path_operator_equal(&_node_path, &other._node_path);
 }
 
-void NodePath::operator=(const NodePath &other) {
-	Pandemonium::api->pandemonium_node_path_destroy(&_node_path);
+bool NodePath::operator!=(const NodePath &other) const {
+	return !(*this == other);
+}
 
-	String other_string = (String)other;
+void NodePath::operator=(const NodePath &other) {
+	if (this == &other) {
+		return;
+	}
 
-	Pandemonium::api->pandemonium_node_path_new(&_node_path, (pandemonium_string *)&other_string);
+	Pandemonium::api->pandemonium_node_path_destroy(&_node_path);
+	Pandemonium::api->pandemonium_node_path_new_copy(&_node_path, &other._node_path);
+	_hash.store(other._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
 }
 
 NodePath::~NodePath() {
 	Pandemonium::api->pandemonium_node_path_destroy(&_node_path);
 }
+
+static SpinLock static_node_path_lock;
+static StaticNodePath *static_node_path_list = nullptr;
+
+NodePath *StaticNodePath::_intern() {
+	static_node_path_lock.lock();
+
+	NodePath *path = _path.load(std::memory_order_relaxed);
+	if (!path) {
+		path = new (_storage) NodePath(_literal);
+		path->hash();
+
+		_next = static_node_path_list;
+		static_node_path_list = this;
+		_path.store(path, std::memory_order_release);
+	}
+
+	static_node_path_lock.unlock();
+
+	return path;
+}
+
+void StaticNodePath::cleanup() {
+	static_node_path_lock.lock();
+
+	StaticNodePath *npath = static_node_path_list;
+	while (npath) {
+		StaticNodePath *next = npath->_next;
+
+		npath->_path.load(std::memory_order_relaxed)->~NodePath();
+		npath->_path.store(nullptr, std::memory_order_relaxed);
+		npath->_next = nullptr;
+
+		npath = next;
+	}
+	static_node_path_list = nullptr;
+
+	static_node_path_lock.unlock();
+}
@@ -34,13 +34,21 @@
 
 #include <gdn/node_path.h>
 
+#include "defs.h"
+
+#include <atomic>
+
 class String;
 
 class NodePath {
 	pandemonium_node_path _node_path;
+	// Engine hash of the path, 0 until first requested. Shared paths such as
+	// NPATH() are hashed from any thread, every writer stores the same value.
+	mutable std::atomic<uint32_t> _hash;
 
 	friend class Variant;
-	inline explicit NodePath(pandemonium_node_path node_path) {
+	inline explicit NodePath(pandemonium_node_path node_path) :
+			_hash(0) {
 		_node_path = node_path;
 	}
 
@@ -74,9 +82,43 @@ public:
 	operator String() const;
 
 	void operator=(const NodePath &other);
-	bool operator==(const NodePath &other);
+	bool operator==(const NodePath &other) const;
+	bool operator!=(const NodePath &other) const;
 
 	~NodePath();
 };
 
+// Lazily parsed NodePath for a string literal, see NPATH().
+// Works like StaticStringName: instances are expected to have static
+// storage duration, and cleanup() releases every path when the library
+// is terminated.
+class StaticNodePath {
+	const char *_literal;
+	std::atomic<NodePath *> _path;
+	StaticNodePath *_next;
+	alignas(NodePath) uint8_t _storage[sizeof(NodePath)];
+
+	NodePath *_intern();
+
+public:
+	_FORCE_INLINE_ const NodePath &get() {
+		NodePath *path = _path.load(std::memory_order_acquire);
+		if (unlikely(!path)) {
+			path = _intern();
+		}
+		return *path;
+	}
+
+	static void cleanup();
+
+	explicit StaticNodePath(const char *p_literal) :
+			_literal(p_literal),
+			_path(nullptr),
+			_next(nullptr) {}
+};
+
+// Parses a node path literal once per call site; later evaluations return
+// the same NodePath with its hash already cached.
+#define NPATH(m_path) ([]() -> const NodePath & { static StaticNodePath npath(m_path); return npath.get(); })()
+
 #endif // NODEPATH_H
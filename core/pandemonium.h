@@ -41,6 +41,7 @@
 #include <nativescript/pandemonium_nativescript.h>
 
 #include "core/core_types.h"
+#include "core/instance_pool.h"
 #include "core/tag_db.h"
 #include "core/variant.h"
 #include "gen/reference.h"
@@ -55,7 +56,7 @@ namespace PandemoniumDetail {
 // They all inherit `_Wrapped`.
 template <class T>
 T *get_wrapper(pandemonium_object *obj) {
-	return (T *)Pandemonium::nativescript_api->pandemonium_nativescript_get_instance_binding_data(_RegisterState::language_index, obj);
+	return (T *)_WrapperCache::get(obj);
 }
 
 // Custom class instances are not obtainable by just casting the pointer to the base class they inherit,
@@ -66,35 +67,40 @@ T *get_custom_class_instance(const Object *obj) {
 	return (obj) ? (T *)Pandemonium::nativescript_api->pandemonium_nativescript_get_userdata(obj->_owner) : nullptr;
 }
 
+#ifdef DEBUG_ENABLED
+// Casts trust the tag cached on custom class instances, debug builds make sure
+// the engine still agrees with it.
+inline void _validate_type_tag(const _Wrapped *p_instance) {
+	const size_t engine_tag = (size_t)Pandemonium::nativescript_api->pandemonium_nativescript_get_type_tag(p_instance->_owner);
+	if (unlikely(engine_tag != p_instance->_type_tag)) {
+		ERR_PRINT("Cached type tag of a custom class instance does not match the one of its script.");
+	}
+}
+#endif
+
+// NativeScript resource attached to the instances of T created from native code.
+template <class T>
+_FORCE_INLINE_ pandemonium_object *get_class_script() {
+	static std::atomic<pandemonium_object *> script(nullptr);
+
+	pandemonium_object *s = script.load(std::memory_order_acquire);
+	if (unlikely(!s)) {
+		s = _ScriptCache::get(script, T::___get_class_name());
+	}
+	return s;
+}
+
 template <class T>
 inline T *create_custom_class_instance() {
 	// Usually, script instances hold a reference to their NativeScript resource.
 	// that resource is obtained from a `.gdns` file, which in turn exists because
 	// of the resource system of Pandemonium. We can't cleanly hardcode that here,
-	// so the easiest for now (though not really clean) is to create new resource instances,
-	// individually attached to the script instances.
-
-	// We cannot use wrappers because of https://github.com/pandemoniumengine/pandemonium/issues/39181
-	//	Pandemonium::NativeScript *script = Pandemonium::NativeScript::_new();
-	//	script->set_library(get_wrapper<Pandemonium::GDNativeLibrary>((pandemonium_object *)Pandemonium::gdnlib));
-	//	script->set_class_name(T::___get_class_name());
+	// so each class gets a single script resource on first use, shared by all its
+	// instances and released when NativeScript terminates.
 
 	static_assert(T::___CLASS_IS_SCRIPT, "This function must only be used on custom classes");
 
-	// So we use the C API directly.
-	static pandemonium_class_constructor script_constructor = Pandemonium::api->pandemonium_get_class_constructor("NativeScript");
-	static pandemonium_method_bind *mb_set_library = Pandemonium::api->pandemonium_method_bind_get_method("NativeScript", "set_library");
-	static pandemonium_method_bind *mb_set_class_name = Pandemonium::api->pandemonium_method_bind_get_method("NativeScript", "set_class_name");
-	pandemonium_object *script = script_constructor();
-	{
-		const void *args[] = { Pandemonium::gdnlib };
-		Pandemonium::api->pandemonium_method_bind_ptrcall(mb_set_library, script, args, nullptr);
-	}
-	{
-		const String class_name = T::___get_class_name();
-		const void *args[] = { &class_name };
-		Pandemonium::api->pandemonium_method_bind_ptrcall(mb_set_class_name, script, args, nullptr);
-	}
+	pandemonium_object *script = get_class_script<T>();
 
 	// Now to instanciate T, we initially did this, however in case of Reference it returns a variant with refcount
 	// already initialized, which woud cause inconsistent behavior compared to other classes (we still have to return a pointer).
@@ -189,6 +195,7 @@ void *_pandemonium_class_instance_func(pandemonium_object *p, void * /*method_da
 	T *d = new T();
 	d->_owner = p;
 	d->_type_tag = typeid(T).hash_code();
+	d->_is_script_instance = true;
 	d->_init();
 	return d;
 }
@@ -199,6 +206,29 @@ void _pandemonium_class_destroy_func(pandemonium_object * /*p*/, void * /*method
 	delete d;
 }
 
+// Pool used for the instances of T when it is registered with register_pooled_class().
+// The page size only matters on the first call, which is made when registering.
+template <class T>
+InstancePool<T> &_pandemonium_class_pool(uint32_t p_page_size = 128) {
+	static InstancePool<T> pool(T::___get_class_name(), p_page_size);
+	return pool;
+}
+
+template <class T>
+void *_pandemonium_class_pooled_instance_func(pandemonium_object *p, void * /*method_data*/) {
+	T *d = _pandemonium_class_pool<T>().alloc();
+	d->_owner = p;
+	d->_type_tag = typeid(T).hash_code();
+	d->_is_script_instance = true;
+	d->_init();
+	return d;
+}
+
+template <class T>
+void _pandemonium_class_pooled_destroy_func(pandemonium_object * /*p*/, void * /*method_data*/, void *data) {
+	_pandemonium_class_pool<T>().free((T *)data);
+}
+
 template <class T>
 void register_class() {
 	static_assert(T::___CLASS_IS_SCRIPT, "This function must only be used on custom classes");
@@ -220,6 +250,33 @@ void register_class() {
 	T::_register_methods();
 }
 
+// Same as register_class(), with instances allocated from a pool of pages
+// holding p_page_size instances each, instead of one heap allocation per
+// instance. Meant for classes with many short-lived instances, like
+// projectiles. Live and peak counts are listed in InstancePoolStats.
+template <class T>
+void register_pooled_class(uint32_t p_page_size = 128) {
+	static_assert(T::___CLASS_IS_SCRIPT, "This function must only be used on custom classes");
+
+	_pandemonium_class_pool<T>(p_page_size);
+
+	pandemonium_instance_create_func create = {};
+	create.create_func = _pandemonium_class_pooled_instance_func<T>;
+
+	pandemonium_instance_destroy_func destroy = {};
+	destroy.destroy_func = _pandemonium_class_pooled_destroy_func<T>;
+
+	_TagDB::register_type(T::___get_id(), T::___get_base_id());
+
+	Pandemonium::nativescript_api->pandemonium_nativescript_register_class(_RegisterState::nativescript_handle,
+			T::___get_class_name(), T::___get_base_class_name(), create, destroy);
+
+	Pandemonium::nativescript_api->pandemonium_nativescript_set_type_tag(_RegisterState::nativescript_handle,
+			T::___get_class_name(), (const void *)T::___get_id());
+
+	T::_register_methods();
+}
+
 template <class T>
 void register_tool_class() {
 	static_assert(T::___CLASS_IS_SCRIPT, "This function must only be used on custom classes");
@@ -424,6 +481,115 @@ struct _PropertyDefaultGetFunc {
 	}
 };
 
+// Plain value types are converted straight between the engine variant and the
+// member, with a single call each way. The generic accessors above go through
+// Variant temporaries, which costs a nil init, a copy and a destroy per access.
+template <class P>
+struct _PropertyPOD {
+	static const bool DIRECT = false;
+};
+
+#define PANDEMONIUM_PROPERTY_POD_SCALAR(m_type, m_new, m_as)                        \
+	template <>                                                                     \
+	struct _PropertyPOD<m_type> {                                                   \
+		static const bool DIRECT = true;                                            \
+		static _FORCE_INLINE_ void get(pandemonium_variant *r_dst, m_type p_src) { \
+			Pandemonium::api->m_new(r_dst, p_src);                                  \
+		}                                                                           \
+		static _FORCE_INLINE_ m_type set(const pandemonium_variant *p_src) {       \
+			return (m_type)Pandemonium::api->m_as(p_src);                           \
+		}                                                                           \
+	};
+
+#define PANDEMONIUM_PROPERTY_POD_STRUCT(m_type, m_name)                                                 \
+	template <>                                                                                         \
+	struct _PropertyPOD<m_type> {                                                                       \
+		static const bool DIRECT = true;                                                                \
+		static _FORCE_INLINE_ void get(pandemonium_variant *r_dst, const m_type &p_src) {              \
+			Pandemonium::api->pandemonium_variant_new_##m_name(r_dst, (pandemonium_##m_name *)&p_src); \
+		}                                                                                               \
+		static _FORCE_INLINE_ m_type set(const pandemonium_variant *p_src) {                           \
+			pandemonium_##m_name v = Pandemonium::api->pandemonium_variant_as_##m_name(p_src);         \
+			return *(m_type *)&v;                                                                       \
+		}                                                                                               \
+	};
+
+PANDEMONIUM_PROPERTY_POD_SCALAR(bool, pandemonium_variant_new_bool, pandemonium_variant_booleanize)
+PANDEMONIUM_PROPERTY_POD_SCALAR(signed int, pandemonium_variant_new_int, pandemonium_variant_as_int)
+PANDEMONIUM_PROPERTY_POD_SCALAR(int64_t, pandemonium_variant_new_int, pandemonium_variant_as_int)
+PANDEMONIUM_PROPERTY_POD_SCALAR(float, pandemonium_variant_new_real, pandemonium_variant_as_real)
+PANDEMONIUM_PROPERTY_POD_SCALAR(double, pandemonium_variant_new_real, pandemonium_variant_as_real)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Vector2, vector2)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Vector2i, vector2i)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Vector3, vector3)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Vector3i, vector3i)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Vector4, vector4)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Vector4i, vector4i)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Rect2, rect2)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Rect2i, rect2i)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Plane, plane)
+PANDEMONIUM_PROPERTY_POD_STRUCT(::AABB, aabb)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Quaternion, quaternion)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Basis, basis)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Transform2D, transform2d)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Transform, transform)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Projection, projection)
+PANDEMONIUM_PROPERTY_POD_STRUCT(Color, color)
+
+#undef PANDEMONIUM_PROPERTY_POD_SCALAR
+#undef PANDEMONIUM_PROPERTY_POD_STRUCT
+
+template <class T, class P>
+struct _PropertyDirectSetFunc {
+	void (T::*f)(P);
+	static void _wrapped_setter(pandemonium_object * /*object*/, void *method_data, void *user_data, pandemonium_variant *value) {
+		_PropertyDirectSetFunc<T, P> *set_func = (_PropertyDirectSetFunc<T, P> *)method_data;
+		T *obj = (T *)user_data;
+
+		(obj->*(set_func->f))(_PropertyPOD<typename std::decay<P>::type>::set(value));
+	}
+};
+
+template <class T, class P>
+struct _PropertyDirectGetFunc {
+	P(T::*f)
+	();
+	static pandemonium_variant _wrapped_getter(pandemonium_object * /*object*/, void *method_data, void *user_data) {
+		_PropertyDirectGetFunc<T, P> *get_func = (_PropertyDirectGetFunc<T, P> *)method_data;
+		T *obj = (T *)user_data;
+
+		pandemonium_variant var;
+		_PropertyPOD<typename std::decay<P>::type>::get(&var, (obj->*(get_func->f))());
+		return var;
+	}
+};
+
+template <class T, class P>
+struct _PropertyDirectDefaultSetFunc {
+	P(T::*f);
+	static void _wrapped_setter(pandemonium_object * /*object*/, void *method_data, void *user_data, pandemonium_variant *value) {
+		_PropertyDirectDefaultSetFunc<T, P> *set_func = (_PropertyDirectDefaultSetFunc<T, P> *)method_data;
+		T *obj = (T *)user_data;
+
+		(obj->*(set_func->f)) = _PropertyPOD<P>::set(value);
+	}
+};
+
+template <class T, class P>
+struct _PropertyDirectDefaultGetFunc {
+	P(T::*f);
+	static pandemonium_variant _wrapped_getter(pandemonium_object * /*object*/, void *method_data, void *user_data) {
+		_PropertyDirectDefaultGetFunc<T, P> *get_func = (_PropertyDirectDefaultGetFunc<T, P> *)method_data;
+		T *obj = (T *)user_data;
+
+		pandemonium_variant var;
+		_PropertyPOD<P>::get(&var, obj->*(get_func->f));
+		return var;
+	}
+};
+
+// Members and accessors of the types above are registered with the direct
+// functions, everything else keeps going through Variant.
 template <class T, class P>
 void register_property(const char *name, P(T::*var), P default_value,
 		pandemonium_method_rpc_mode rpc_mode = PANDEMONIUM_METHOD_RPC_MODE_DISABLED,
@@ -458,23 +624,24 @@ void register_property(const char *name, P(T::*var), P default_value,
 	attr.usage = usage;
 	attr.hint_string = *_hint_string;
 
-	_PropertyDefaultSetFunc<T, P> *wrapped_set =
-			(_PropertyDefaultSetFunc<T, P> *)Pandemonium::api->pandemonium_alloc(sizeof(_PropertyDefaultSetFunc<T, P>));
+	typedef typename std::conditional<_PropertyPOD<P>::DIRECT, _PropertyDirectDefaultSetFunc<T, P>, _PropertyDefaultSetFunc<T, P>>::type SetFunc;
+	typedef typename std::conditional<_PropertyPOD<P>::DIRECT, _PropertyDirectDefaultGetFunc<T, P>, _PropertyDefaultGetFunc<T, P>>::type GetFunc;
+
+	SetFunc *wrapped_set = (SetFunc *)Pandemonium::api->pandemonium_alloc(sizeof(SetFunc));
 	wrapped_set->f = var;
 
-	_PropertyDefaultGetFunc<T, P> *wrapped_get =
-			(_PropertyDefaultGetFunc<T, P> *)Pandemonium::api->pandemonium_alloc(sizeof(_PropertyDefaultGetFunc<T, P>));
+	GetFunc *wrapped_get = (GetFunc *)Pandemonium::api->pandemonium_alloc(sizeof(GetFunc));
 	wrapped_get->f = var;
 
 	pandemonium_property_set_func set_func = {};
 	set_func.method_data = (void *)wrapped_set;
 	set_func.free_func = Pandemonium::api->pandemonium_free;
-	set_func.set_func = &_PropertyDefaultSetFunc<T, P>::_wrapped_setter;
+	set_func.set_func = &SetFunc::_wrapped_setter;
 
 	pandemonium_property_get_func get_func = {};
 	get_func.method_data = (void *)wrapped_get;
 	get_func.free_func = Pandemonium::api->pandemonium_free;
-	get_func.get_func = &_PropertyDefaultGetFunc<T, P>::_wrapped_getter;
+	get_func.get_func = &GetFunc::_wrapped_getter;
 
 	Pandemonium::nativescript_api->pandemonium_nativescript_register_property(_RegisterState::nativescript_handle,
 			T::___get_class_name(), name, &attr, set_func, get_func);
@@ -503,21 +670,25 @@ void register_property(const char *name, void (T::*setter)(P), P (T::*getter)(),
 	attr.usage = usage;
 	attr.hint_string = *_hint_string;
 
-	_PropertySetFunc<T, P> *wrapped_set = (_PropertySetFunc<T, P> *)Pandemonium::api->pandemonium_alloc(sizeof(_PropertySetFunc<T, P>));
+	const bool direct = _PropertyPOD<typename std::decay<P>::type>::DIRECT;
+	typedef typename std::conditional<direct, _PropertyDirectSetFunc<T, P>, _PropertySetFunc<T, P>>::type SetFunc;
+	typedef typename std::conditional<direct, _PropertyDirectGetFunc<T, P>, _PropertyGetFunc<T, P>>::type GetFunc;
+
+	SetFunc *wrapped_set = (SetFunc *)Pandemonium::api->pandemonium_alloc(sizeof(SetFunc));
 	wrapped_set->f = setter;
 
-	_PropertyGetFunc<T, P> *wrapped_get = (_PropertyGetFunc<T, P> *)Pandemonium::api->pandemonium_alloc(sizeof(_PropertyGetFunc<T, P>));
+	GetFunc *wrapped_get = (GetFunc *)Pandemonium::api->pandemonium_alloc(sizeof(GetFunc));
 	wrapped_get->f = getter;
 
 	pandemonium_property_set_func set_func = {};
 	set_func.method_data = (void *)wrapped_set;
 	set_func.free_func = Pandemonium::api->pandemonium_free;
-	set_func.set_func = &_PropertySetFunc<T, P>::_wrapped_setter;
+	set_func.set_func = &SetFunc::_wrapped_setter;
 
 	pandemonium_property_get_func get_func = {};
 	get_func.method_data = (void *)wrapped_get;
 	get_func.free_func = Pandemonium::api->pandemonium_free;
-	get_func.get_func = &_PropertyGetFunc<T, P>::_wrapped_getter;
+	get_func.get_func = &GetFunc::_wrapped_getter;
 
 	Pandemonium::nativescript_api->pandemonium_nativescript_register_property(_RegisterState::nativescript_handle,
 			T::___get_class_name(), name, &attr, set_func, get_func);
@@ -546,17 +717,14 @@ void register_signal(String name, Dictionary args) {
 		memset((void *)signal.args, 0, sizeof(pandemonium_signal_argument) * signal.num_args);
 	}
 
-	for (int i = 0; i < signal.num_args; i++) {
-		// Array entry = args[i];
-		// String name = entry[0];
-		String name = args.keys()[i];
+	int i = 0;
+	for (const Dictionary::Element &E : args) {
+		String name = E.key();
 		pandemonium_string *_key = (pandemonium_string *)&name;
 		Pandemonium::api->pandemonium_string_new_copy(&signal.args[i].name, _key);
 
-		// if (entry.size() > 1) {
-		// 	signal.args[i].type = entry[1];
-		// }
-		signal.args[i].type = args.values()[i];
+		signal.args[i].type = E.value();
+		i++;
 	}
 
 	Pandemonium::nativescript_api->pandemonium_nativescript_register_signal(_RegisterState::nativescript_handle,
@@ -594,6 +762,20 @@ T *Object::cast_to(const Object *obj) {
 		return nullptr;
 
 	if (T::___CLASS_IS_SCRIPT) {
+		if (obj->_is_script_instance) {
+			// The tag was set when the instance was created for its script, and the
+			// instance goes away with it, so there is no need to ask the engine.
+			// The instance is its own userdata, it is returned as is.
+#ifdef DEBUG_ENABLED
+			PandemoniumDetail::_validate_type_tag(obj);
+#endif
+			if (_TagDB::is_type_compatible(T::___get_id(), obj->_type_tag)) {
+				return static_cast<T *>(const_cast<Object *>(obj));
+			}
+			return nullptr;
+		}
+
+		// A wrapper only knows the engine class, a script may have been attached since.
 		size_t have_tag = (size_t)Pandemonium::nativescript_api->pandemonium_nativescript_get_type_tag(obj->_owner);
 		if (have_tag) {
 			if (!_TagDB::is_type_known((size_t)have_tag)) {
@@ -30,25 +30,67 @@
 
 #include "pandemonium_global.h"
 
+#include <string.h>
+
 #include "array.h"
+#include "core/containers/vector.h"
+#include "instance_pool.h"
+#include "node_path.h"
+#include "os/spin_lock.h"
+#include "string_name.h"
+#include "string_view.h"
+#include "tag_db.h"
 #include "ustring.h"
 
 #include "wrapped.h"
 
+// Every engine object seen from the bindings gets a wrapper, they come from
+// pages instead of one engine allocation each. The engine may create and free
+// them from any thread, so the pool takes no lock.
+static LockFreeInstancePool<_Wrapped> &wrapper_pool() {
+	static LockFreeInstancePool<_Wrapped> pool("_Wrapped", 1024);
+	return pool;
+}
+
 static GDCALLINGCONV void *wrapper_create(void *data, const void *type_tag, pandemonium_object *instance) {
-	_Wrapped *wrapper_memory = (_Wrapped *)Pandemonium::api->pandemonium_alloc(sizeof(_Wrapped));
+	_Wrapped *wrapper_memory = wrapper_pool().alloc();
 
 	if (!wrapper_memory)
 		return NULL;
 	wrapper_memory->_owner = instance;
 	wrapper_memory->_type_tag = (size_t)type_tag;
+	wrapper_memory->_is_script_instance = false;
 
 	return (void *)wrapper_memory;
 }
 
 static GDCALLINGCONV void wrapper_destroy(void *data, void *wrapper) {
-	if (wrapper)
-		Pandemonium::api->pandemonium_free(wrapper);
+	if (wrapper) {
+		_WrapperCache::invalidate();
+		wrapper_pool().free((_Wrapped *)wrapper);
+	}
+}
+
+std::atomic<uint64_t> _WrapperCache::epoch(1);
+thread_local _WrapperCache::Table _WrapperCache::table = {};
+
+void *_WrapperCache::_lookup(pandemonium_object *p_object, uint64_t p_epoch) {
+	if (!p_object) {
+		return nullptr;
+	}
+
+	Table &t = table;
+	if (t.epoch != p_epoch) {
+		memset(t.entries, 0, sizeof(t.entries));
+		t.epoch = p_epoch;
+	}
+
+	void *wrapper = Pandemonium::nativescript_api->pandemonium_nativescript_get_instance_binding_data(_RegisterState::language_index, p_object);
+
+	Entry &e = t.entries[_slot(p_object)];
+	e.object = p_object;
+	e.wrapper = wrapper;
+	return wrapper;
 }
 
 void *_RegisterState::nativescript_handle;
@@ -69,41 +111,31 @@ void Pandemonium::print(const String &message) {
 }
 
 void Pandemonium::print_warning(const String &description, const String &function, const String &file, int line) {
-	int len;
+	Utf8ScratchString c_desc(description);
+	Utf8ScratchString c_func(function);
+	Utf8ScratchString c_file(file);
 
-	char *c_desc = description.alloc_c_string();
-	char *c_func = function.alloc_c_string();
-	char *c_file = file.alloc_c_string();
+	Pandemonium::api->pandemonium_print_warning(c_desc.get_data(), c_func.get_data(), c_file.get_data(), line);
+}
 
-	if (c_desc != nullptr && c_func != nullptr && c_file != nullptr) {
-		Pandemonium::api->pandemonium_print_warning(c_desc, c_func, c_file, line);
-	};
+void Pandemonium::print_warning(const String &description, const char *function, const char *file, int line) {
+	Utf8ScratchString c_desc(description);
 
-	if (c_desc != nullptr)
-		Pandemonium::api->pandemonium_free(c_desc);
-	if (c_func != nullptr)
-		Pandemonium::api->pandemonium_free(c_func);
-	if (c_file != nullptr)
-		Pandemonium::api->pandemonium_free(c_file);
+	Pandemonium::api->pandemonium_print_warning(c_desc.get_data(), function, file, line);
 }
 
 void Pandemonium::print_error(const String &description, const String &function, const String &file, int line) {
-	int len;
+	Utf8ScratchString c_desc(description);
+	Utf8ScratchString c_func(function);
+	Utf8ScratchString c_file(file);
 
-	char *c_desc = description.alloc_c_string();
-	char *c_func = function.alloc_c_string();
-	char *c_file = file.alloc_c_string();
+	Pandemonium::api->pandemonium_print_error(c_desc.get_data(), c_func.get_data(), c_file.get_data(), line);
+}
 
-	if (c_desc != nullptr && c_func != nullptr && c_file != nullptr) {
-		Pandemonium::api->pandemonium_print_error(c_desc, c_func, c_file, line);
-	};
+void Pandemonium::print_error(const String &description, const char *function, const char *file, int line) {
+	Utf8ScratchString c_desc(description);
 
-	if (c_desc != nullptr)
-		Pandemonium::api->pandemonium_free(c_desc);
-	if (c_func != nullptr)
-		Pandemonium::api->pandemonium_free(c_func);
-	if (c_file != nullptr)
-		Pandemonium::api->pandemonium_free(c_file);
+	Pandemonium::api->pandemonium_print_error(c_desc.get_data(), function, file, line);
 }
 
 void ___register_types();
@@ -187,7 +219,10 @@ void Pandemonium::gdnative_init(pandemonium_gdnative_init_options *options) {
 }
 
 void Pandemonium::gdnative_terminate(pandemonium_gdnative_terminate_options *options) {
-	// reserved for future use.
+	StaticStringName::cleanup();
+	StaticNodePath::cleanup();
+	_TagDB::cleanup();
+	_WrapperCache::invalidate();
 }
 
 void Pandemonium::gdnative_profiling_add_data(const char *p_signature, uint64_t p_time) {
@@ -199,5 +234,68 @@ void Pandemonium::nativescript_init(void *handle) {
 }
 
 void Pandemonium::nativescript_terminate(void *handle) {
+	_ScriptCache::release_all();
 	Pandemonium::nativescript_api->pandemonium_nativescript_unregister_instance_binding_data_functions(_RegisterState::language_index);
+	_WrapperCache::invalidate();
+}
+
+static SpinLock script_cache_lock;
+static Vector<std::atomic<pandemonium_object *> *> script_cache_slots;
+
+pandemonium_object *_ScriptCache::get(std::atomic<pandemonium_object *> &r_slot, const char *p_class_name) {
+	// We cannot use wrappers because of https://github.com/pandemoniumengine/pandemonium/issues/39181
+	static pandemonium_class_constructor script_constructor = Pandemonium::api->pandemonium_get_class_constructor("NativeScript");
+	static pandemonium_method_bind *mb_set_library = Pandemonium::api->pandemonium_method_bind_get_method("NativeScript", "set_library");
+	static pandemonium_method_bind *mb_set_class_name = Pandemonium::api->pandemonium_method_bind_get_method("NativeScript", "set_class_name");
+	static pandemonium_method_bind *mb_init_ref = Pandemonium::api->pandemonium_method_bind_get_method("Reference", "init_ref");
+
+	script_cache_lock.lock();
+
+	pandemonium_object *script = r_slot.load(std::memory_order_relaxed);
+	if (!script) {
+		script = script_constructor();
+		{
+			const void *args[] = { Pandemonium::gdnlib };
+			Pandemonium::api->pandemonium_method_bind_ptrcall(mb_set_library, script, args, nullptr);
+		}
+		{
+			const String class_name = p_class_name;
+			const void *args[] = { &class_name };
+			Pandemonium::api->pandemonium_method_bind_ptrcall(mb_set_class_name, script, args, nullptr);
+		}
+
+		// The cache holds its own reference, so the script outlives the instances using it.
+		bool referenced = false;
+		Pandemonium::api->pandemonium_method_bind_ptrcall(mb_init_ref, script, nullptr, &referenced);
+
+		script_cache_slots.push_back(&r_slot);
+		r_slot.store(script, std::memory_order_release);
+	}
+
+	script_cache_lock.unlock();
+
+	return script;
+}
+
+void _ScriptCache::release_all() {
+	static pandemonium_method_bind *mb_unreference = Pandemonium::api->pandemonium_method_bind_get_method("Reference", "unreference");
+
+	script_cache_lock.lock();
+
+	for (int i = 0; i < script_cache_slots.size(); i++) {
+		pandemonium_object *script = script_cache_slots[i]->exchange(nullptr, std::memory_order_acq_rel);
+		if (!script) {
+			continue;
+		}
+
+		// Instances still alive keep their own reference to the script.
+		bool last = false;
+		Pandemonium::api->pandemonium_method_bind_ptrcall(mb_unreference, script, nullptr, &last);
+		if (last) {
+			Pandemonium::api->pandemonium_object_destroy(script);
+		}
+	}
+	script_cache_slots.clear();
+
+	script_cache_lock.unlock();
 }
@@ -33,6 +33,9 @@
 
 #include <gdnative_api_struct.gen.h>
 
+#include <atomic>
+#include <cstdint>
+
 #include "array.h"
 #include "ustring.h"
 
@@ -44,6 +47,9 @@ public:
 	static void print(const String &message);
 	static void print_warning(const String &description, const String &function, const String &file, int line);
 	static void print_error(const String &description, const String &function, const String &file, int line);
+	// Used by the WARN_PRINT/ERR_PRINT macros, which pass __func__ and __FILE__ as is.
+	static void print_warning(const String &description, const char *function, const char *file, int line);
+	static void print_error(const String &description, const char *function, const char *file, int line);
 
 	static void gdnative_init(pandemonium_gdnative_init_options *o);
 	static void gdnative_terminate(pandemonium_gdnative_terminate_options *o);
@@ -73,4 +79,61 @@ struct _RegisterState {
 	static int language_index;
 };
 
+// NativeScript resources shared by every instance of a custom class created
+// from native code. Each slot gets its script on first use, and all of them
+// are released in nativescript_terminate().
+struct _ScriptCache {
+	static pandemonium_object *get(std::atomic<pandemonium_object *> &r_slot, const char *p_class_name);
+	static void release_all();
+};
+
+// Wrappers of the engine objects looked up recently by the current thread,
+// in a small direct-mapped table, so walking the same nodes again does not go
+// back to the engine. A wrapper being destroyed anywhere bumps the epoch and
+// with it empties every table, since its object's address can be reused. The
+// epoch is 64-bit so it cannot wrap around to an idle thread's stale value.
+struct _WrapperCache {
+	enum {
+		SIZE_SHIFT = 6,
+		SIZE = 1 << SIZE_SHIFT,
+	};
+
+	struct Entry {
+		pandemonium_object *object;
+		void *wrapper;
+	};
+
+	struct Table {
+		uint64_t epoch;
+		Entry entries[SIZE];
+	};
+
+	static std::atomic<uint64_t> epoch;
+	static thread_local Table table;
+
+	static void *_lookup(pandemonium_object *p_object, uint64_t p_epoch);
+
+	// Fibonacci hashing, objects are allocated with any spacing.
+	static inline uint32_t _slot(pandemonium_object *p_object) {
+		return (uint32_t)(((uint64_t)(uintptr_t)p_object * 0x9E3779B97F4A7C15ull) >> (64 - SIZE_SHIFT));
+	}
+
+	// Not using the defs.h macros, which may not be defined yet here.
+	static inline void *get(pandemonium_object *p_object) {
+		const uint64_t current = epoch.load(std::memory_order_acquire);
+		Table &t = table;
+		if (t.epoch == current) {
+			const Entry &e = t.entries[_slot(p_object)];
+			if (e.object == p_object) {
+				return e.wrapper;
+			}
+		}
+		return _lookup(p_object, current);
+	}
+
+	static inline void invalidate() {
+		epoch.fetch_add(1, std::memory_order_acq_rel);
+	}
+};
+
 #endif
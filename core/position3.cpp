@@ -0,0 +1,69 @@
+/*************************************************************************/
+/*  position3.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "position3.h"
+
+#include "ustring.h"
+
+void Position3::to_local_n(const Position3 *p_src, const Position3 &p_origin, Vector3 *r_dst, int p_count) {
+	const position_t ox = p_origin.x, oy = p_origin.y, oz = p_origin.z;
+	for (int i = 0; i < p_count; ++i) {
+		r_dst[i].x = (real_t)(p_src[i].x - ox);
+		r_dst[i].y = (real_t)(p_src[i].y - oy);
+		r_dst[i].z = (real_t)(p_src[i].z - oz);
+	}
+}
+
+void Position3::from_local_n(const Vector3 *p_src, const Position3 &p_origin, Position3 *r_dst, int p_count) {
+	const position_t ox = p_origin.x, oy = p_origin.y, oz = p_origin.z;
+	for (int i = 0; i < p_count; ++i) {
+		r_dst[i].x = ox + p_src[i].x;
+		r_dst[i].y = oy + p_src[i].y;
+		r_dst[i].z = oz + p_src[i].z;
+	}
+}
+
+Position3::operator String() const {
+	return String::num(x) + ", " + String::num(y) + ", " + String::num(z);
+}
+
+void PositionTransform::to_local_n(const PositionTransform *p_src, const Position3 &p_origin, Transform *r_dst, int p_count) {
+	for (int i = 0; i < p_count; ++i) {
+		r_dst[i].basis = p_src[i].basis;
+		r_dst[i].origin = p_src[i].origin.to_local(p_origin);
+	}
+}
+
+void PositionTransform::from_local_n(const Transform *p_src, const Position3 &p_origin, PositionTransform *r_dst, int p_count) {
+	for (int i = 0; i < p_count; ++i) {
+		r_dst[i].basis = p_src[i].basis;
+		r_dst[i].origin = p_origin + p_src[i].origin;
+	}
+}
@@ -0,0 +1,126 @@
+#ifndef POSITION3_H
+#define POSITION3_H
+
+/*************************************************************************/
+/*  position3.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "defs.h"
+
+#include "basis.h"
+#include "transform.h"
+#include "vector3.h"
+
+class String;
+
+// World space position in position_t precision, which is double in mixed precision builds.
+// Vector3 and Transform have to stay in real_t, as they share their layout with the engine, so large worlds keep
+// their positions as Position3 and hand them to the engine relative to a nearby origin, such as the camera or the current chunk.
+struct Position3 {
+	position_t x;
+	position_t y;
+	position_t z;
+
+	inline Position3 operator+(const Vector3 &p_offset) const { return Position3(x + p_offset.x, y + p_offset.y, z + p_offset.z); }
+	inline void operator+=(const Vector3 &p_offset) {
+		x += p_offset.x;
+		y += p_offset.y;
+		z += p_offset.z;
+	}
+	inline Position3 operator-(const Vector3 &p_offset) const { return Position3(x - p_offset.x, y - p_offset.y, z - p_offset.z); }
+	inline void operator-=(const Vector3 &p_offset) {
+		x -= p_offset.x;
+		y -= p_offset.y;
+		z -= p_offset.z;
+	}
+
+	inline bool operator==(const Position3 &p_pos) const { return x == p_pos.x && y == p_pos.y && z == p_pos.z; }
+	inline bool operator!=(const Position3 &p_pos) const { return x != p_pos.x || y != p_pos.y || z != p_pos.z; }
+
+	inline position_t distance_squared_to(const Position3 &p_pos) const {
+		position_t dx = p_pos.x - x, dy = p_pos.y - y, dz = p_pos.z - z;
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	// The difference is taken in position_t precision before narrowing, so the result is accurate as long as it is small.
+	inline Vector3 to_local(const Position3 &p_origin) const {
+		return Vector3((real_t)(x - p_origin.x), (real_t)(y - p_origin.y), (real_t)(z - p_origin.z));
+	}
+	static inline Position3 from_local(const Vector3 &p_local, const Position3 &p_origin) {
+		return p_origin + p_local;
+	}
+
+	// Batched forms, e.g. to fill or read back a PoolVector3Array through its Write and Read pointers.
+	static void to_local_n(const Position3 *p_src, const Position3 &p_origin, Vector3 *r_dst, int p_count);
+	static void from_local_n(const Vector3 *p_src, const Position3 &p_origin, Position3 *r_dst, int p_count);
+
+	operator String() const;
+
+	inline Position3(position_t p_x, position_t p_y, position_t p_z) {
+		x = p_x;
+		y = p_y;
+		z = p_z;
+	}
+
+	explicit inline Position3(const Vector3 &p_vector) {
+		x = p_vector.x;
+		y = p_vector.y;
+		z = p_vector.z;
+	}
+
+	inline Position3() {
+		x = 0;
+		y = 0;
+		z = 0;
+	}
+};
+
+// Transform with a Position3 origin. The basis only holds rotation and scale, so it stays in real_t.
+struct PositionTransform {
+	Basis basis;
+	Position3 origin;
+
+	inline Position3 xform(const Vector3 &p_local) const { return origin + basis.xform(p_local); }
+
+	inline Transform to_local(const Position3 &p_origin) const { return Transform(basis, origin.to_local(p_origin)); }
+	static inline PositionTransform from_local(const Transform &p_local, const Position3 &p_origin) {
+		return PositionTransform(p_local.basis, p_origin + p_local.origin);
+	}
+
+	static void to_local_n(const PositionTransform *p_src, const Position3 &p_origin, Transform *r_dst, int p_count);
+	static void from_local_n(const Transform *p_src, const Position3 &p_origin, PositionTransform *r_dst, int p_count);
+
+	inline PositionTransform(const Basis &p_basis, const Position3 &p_origin) :
+			basis(p_basis),
+			origin(p_origin) {}
+
+	inline PositionTransform() {}
+};
+
+#endif // POSITION3_H
@@ -31,6 +31,7 @@
 #include "quaternion.h"
 #include "basis.h"
 #include "defs.h"
+#include "math_funcs.h"
 #include "vector3.h"
 
 #include <cmath>
@@ -152,10 +153,17 @@ Quaternion Quaternion::slerp(const Quaternion &q, const real_t &t) const {
 
 	if ((1.0 - cosom) > CMP_EPSILON) {
 		// standard case (slerp)
+#ifdef PANDEMONIUM_FAST_MATH
+		omega = Math::fast::acos(cosom);
+		sinom = Math::fast::sin(omega);
+		scale0 = Math::fast::sin((1.0f - t) * omega) / sinom;
+		scale1 = Math::fast::sin(t * omega) / sinom;
+#else
 		omega = ::acos(cosom);
 		sinom = ::sin(omega);
 		scale0 = ::sin((1.0 - t) * omega) / sinom;
 		scale1 = ::sin(t * omega) / sinom;
+#endif
 	} else {
 		// "from" and "to" quaternions are very close
 		//  ... so we can do a linear interpolation
@@ -197,6 +205,101 @@ Quaternion Quaternion::cubic_slerp(const Quaternion &q, const Quaternion &prep,
 	return sp.slerpni(sq, t2);
 }
 
+// The batched functions work in blocks, so that the transcendental parts can go through the vectorised Math::fast kernels.
+static const int QUATERNION_BATCH_BLOCK = 64;
+
+void Quaternion::slerp_n(const SoA &p_from, const SoA &p_to, const real_t *p_weights, const SoA &r_dst, int p_count) {
+	real_t cosom[QUATERNION_BATCH_BLOCK];
+	real_t sign[QUATERNION_BATCH_BLOCK];
+	real_t omega[QUATERNION_BATCH_BLOCK];
+	real_t omega_from[QUATERNION_BATCH_BLOCK];
+	real_t omega_to[QUATERNION_BATCH_BLOCK];
+
+	for (int base = 0; base < p_count; base += QUATERNION_BATCH_BLOCK) {
+		const int count = MIN(QUATERNION_BATCH_BLOCK, p_count - base);
+
+		for (int i = 0; i < count; ++i) {
+			const int j = base + i;
+			real_t d = p_from.x[j] * p_to.x[j] + p_from.y[j] * p_to.y[j] + p_from.z[j] * p_to.z[j] + p_from.w[j] * p_to.w[j];
+			// Take the shortest path, as slerp() does.
+			sign[i] = d < 0 ? -1 : 1;
+			cosom[i] = d * sign[i];
+		}
+
+		Math::fast::acos_n(cosom, omega, count);
+
+		for (int i = 0; i < count; ++i) {
+			omega_from[i] = (1 - p_weights[base + i]) * omega[i];
+			omega_to[i] = p_weights[base + i] * omega[i];
+		}
+
+		// In place, only the sines are needed from here on.
+		Math::fast::sin_n(omega, omega, count);
+		Math::fast::sin_n(omega_from, omega_from, count);
+		Math::fast::sin_n(omega_to, omega_to, count);
+
+		for (int i = 0; i < count; ++i) {
+			const int j = base + i;
+			const real_t t = p_weights[j];
+
+			real_t scale0, scale1;
+			if ((1 - cosom[i]) > CMP_EPSILON) {
+				real_t inv_sinom = 1 / omega[i];
+				scale0 = omega_from[i] * inv_sinom;
+				scale1 = omega_to[i] * inv_sinom;
+			} else {
+				// Very close, fall back to a linear interpolation.
+				scale0 = 1 - t;
+				scale1 = t;
+			}
+			scale1 *= sign[i];
+
+			r_dst.x[j] = scale0 * p_from.x[j] + scale1 * p_to.x[j];
+			r_dst.y[j] = scale0 * p_from.y[j] + scale1 * p_to.y[j];
+			r_dst.z[j] = scale0 * p_from.z[j] + scale1 * p_to.z[j];
+			r_dst.w[j] = scale0 * p_from.w[j] + scale1 * p_to.w[j];
+		}
+	}
+}
+
+void Quaternion::nlerp_n(const SoA &p_from, const SoA &p_to, const real_t *p_weights, const SoA &r_dst, int p_count) {
+	real_t inv_length[QUATERNION_BATCH_BLOCK];
+
+	for (int base = 0; base < p_count; base += QUATERNION_BATCH_BLOCK) {
+		const int count = MIN(QUATERNION_BATCH_BLOCK, p_count - base);
+
+		for (int i = 0; i < count; ++i) {
+			const int j = base + i;
+			const real_t t = p_weights[j];
+
+			real_t d = p_from.x[j] * p_to.x[j] + p_from.y[j] * p_to.y[j] + p_from.z[j] * p_to.z[j] + p_from.w[j] * p_to.w[j];
+			real_t scale0 = 1 - t;
+			real_t scale1 = d < 0 ? -t : t;
+
+			real_t x = scale0 * p_from.x[j] + scale1 * p_to.x[j];
+			real_t y = scale0 * p_from.y[j] + scale1 * p_to.y[j];
+			real_t z = scale0 * p_from.z[j] + scale1 * p_to.z[j];
+			real_t w = scale0 * p_from.w[j] + scale1 * p_to.w[j];
+
+			r_dst.x[j] = x;
+			r_dst.y[j] = y;
+			r_dst.z[j] = z;
+			r_dst.w[j] = w;
+			inv_length[i] = x * x + y * y + z * z + w * w;
+		}
+
+		Math::fast::inv_sqrt_n(inv_length, inv_length, count);
+
+		for (int i = 0; i < count; ++i) {
+			const int j = base + i;
+			r_dst.x[j] *= inv_length[i];
+			r_dst.y[j] *= inv_length[i];
+			r_dst.z[j] *= inv_length[i];
+			r_dst.w[j] *= inv_length[i];
+		}
+	}
+}
+
 void Quaternion::get_axis_and_angle(Vector3 &r_axis, real_t &r_angle) const {
 	r_angle = 2 * ::acos(w);
 	r_axis.x = x / ::sqrt(1 - w * w);
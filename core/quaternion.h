@@ -39,6 +39,14 @@ class Quaternion {
 public:
 	static const Quaternion IDENTITY;
 
+	// Structure of arrays view over quaternion components, as used by the batched functions below.
+	struct SoA {
+		real_t *x;
+		real_t *y;
+		real_t *z;
+		real_t *w;
+	};
+
 	real_t x, y, z, w;
 
 	real_t length_squared() const;
@@ -68,6 +76,13 @@ public:
 
 	Quaternion cubic_slerp(const Quaternion &q, const Quaternion &prep, const Quaternion &postq, const real_t &t) const;
 
+	// Batched forms interpolating p_count pairs, each with its own weight. r_dst may alias p_from or p_to.
+	// slerp_n() uses the Math::fast approximations, so results differ from slerp() by up to about 1e-6.
+	// nlerp_n() normalizes a linear interpolation instead, which is cheaper and close enough for the
+	// small angles between consecutive animation keys, but does not keep a constant angular velocity.
+	static void slerp_n(const SoA &p_from, const SoA &p_to, const real_t *p_weights, const SoA &r_dst, int p_count);
+	static void nlerp_n(const SoA &p_from, const SoA &p_to, const real_t *p_weights, const SoA &r_dst, int p_count);
+
 	void get_axis_and_angle(Vector3 &r_axis, real_t &r_angle) const;
 
 	void set_axis_angle(const Vector3 &axis, const float angle);
@@ -31,10 +31,17 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 
+#include "core/containers/vector.h"
+#include "os/spin_lock.h"
 #include "pandemonium_global.h"
 #include "reference.h"
 #include "variant.h"
 
+template <class T>
+class RefView;
+
+class RefReleaseQueue;
+
 // Replicates Pandemonium's Ref<T> behavior
 // Rewritten from f5234e70be7dec4930c2d5a0e829ff480d044b1d.
 template <class T>
@@ -46,6 +53,10 @@ class Ref {
 
 	T *reference = nullptr;
 
+	template <class T_Other>
+	friend class Ref;
+	friend class RefReleaseQueue;
+
 	void ref(const Ref &p_from) {
 		if (p_from.reference == reference)
 			return;
@@ -108,6 +119,16 @@ public:
 		ref(p_from);
 	}
 
+	// Moving takes over the reference, without calling into the engine.
+	void operator=(Ref &&p_from) {
+		if (&p_from == this) {
+			return;
+		}
+		unref();
+		reference = p_from.reference;
+		p_from.reference = nullptr;
+	}
+
 	template <class T_Other>
 	void operator=(const Ref<T_Other> &p_from) {
 		Reference *refb = const_cast<Reference *>(static_cast<const Reference *>(p_from.ptr()));
@@ -138,6 +159,32 @@ public:
 		ref(p_from);
 	}
 
+	Ref(Ref &&p_from) {
+		reference = p_from.reference;
+		p_from.reference = nullptr;
+	}
+
+	// Takes over the reference if p_from is a T, and leaves p_from untouched otherwise.
+	template <class T_Other>
+	Ref(Ref<T_Other> &&p_from) {
+		reference = nullptr;
+		if (p_from.reference == nullptr) {
+			return;
+		}
+		reference = Object::cast_to<T>(p_from.reference);
+		if (reference) {
+			p_from.reference = nullptr;
+		}
+	}
+
+	// Adds a reference to the object a view points to.
+	explicit Ref(const RefView<T> &p_view) {
+		reference = const_cast<T *>(p_view.ptr());
+		if (reference) {
+			reference->reference();
+		}
+	}
+
 	template <class T_Other>
 	Ref(const Ref<T_Other> &p_from) {
 		reference = nullptr;
@@ -209,4 +256,99 @@ public:
 	}
 };
 
+// Borrowed, non-owning Ref<T>, meant for parameters. Passing a Ref by
+// value costs a reference() and an unreference() call into the engine,
+// passing a view costs nothing. The caller has to keep a Ref alive for
+// as long as the view is used; call to_ref() to keep the object.
+template <class T>
+class RefView {
+	T *reference;
+
+public:
+	inline T *operator->() const { return reference; }
+	inline T *operator*() const { return reference; }
+	inline T *ptr() const { return reference; }
+
+	inline bool is_valid() const { return reference != nullptr; }
+	inline bool is_null() const { return reference == nullptr; }
+
+	inline bool operator==(const RefView &p_r) const { return reference == p_r.reference; }
+	inline bool operator!=(const RefView &p_r) const { return reference != p_r.reference; }
+
+	inline Ref<T> to_ref() const { return Ref<T>(*this); }
+
+	operator Variant() const {
+		return Variant((Object *)reference);
+	}
+
+	RefView() :
+			reference(nullptr) {}
+	RefView(const Ref<T> &p_ref) :
+			reference(const_cast<T *>(p_ref.ptr())) {}
+	template <class T_Other>
+	RefView(const RefView<T_Other> &p_view) :
+			reference(p_view.ptr()) {}
+};
+
+// Collects references to drop later, all at once. Freeing a large tree of
+// resources in the middle of a frame runs every destructor right there;
+// pushing the Refs here instead lets flush() release them at a better
+// time, typically once per frame from a _process() callback.
+// push() is thread safe, flush() releases on the calling thread.
+class RefReleaseQueue {
+	Vector<Reference *> _pending;
+	SpinLock _lock;
+
+	RefReleaseQueue(const RefReleaseQueue &p_from);
+	RefReleaseQueue &operator=(const RefReleaseQueue &p_from);
+
+public:
+	// Takes over the reference held by p_ref, which is left null.
+	template <class T>
+	void push(Ref<T> &p_ref) {
+		if (p_ref.reference == nullptr) {
+			return;
+		}
+
+		_lock.lock();
+		_pending.push_back(p_ref.reference);
+		_lock.unlock();
+
+		p_ref.reference = nullptr;
+	}
+
+	template <class T>
+	void push(Ref<T> &&p_ref) {
+		push(p_ref);
+	}
+
+	int size() {
+		_lock.lock();
+		const int size = _pending.size();
+		_lock.unlock();
+		return size;
+	}
+
+	// Drops every queued reference, freeing the objects nothing else holds.
+	void flush() {
+		_lock.lock();
+		Vector<Reference *> pending = _pending;
+		_pending.clear();
+		_lock.unlock();
+
+		Reference *const *references = pending.ptr();
+		const int count = pending.size();
+		for (int i = 0; i < count; i++) {
+			if (references[i]->unreference()) {
+				references[i]->free();
+			}
+		}
+	}
+
+	RefReleaseQueue() {}
+	~RefReleaseQueue() {
+		flush();
+	}
+};
+
 #endif
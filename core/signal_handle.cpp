@@ -0,0 +1,50 @@
+/*************************************************************************/
+/*  signal_handle.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "signal_handle.h"
+
+#include "pandemonium_global.h"
+
+Error SignalHandle::_emit(pandemonium_object *p_owner, const StringName &p_name, pandemonium_variant *p_args, const pandemonium_variant **p_ptrs, int p_arg_count) {
+	static pandemonium_method_bind *mb = Pandemonium::api->pandemonium_method_bind_get_method("Object", "emit_signal");
+
+	Pandemonium::api->pandemonium_variant_new_string_name(&p_args[0], (pandemonium_string_name *)&p_name);
+
+	pandemonium_variant result = Pandemonium::api->pandemonium_method_bind_call(mb, p_owner, p_ptrs, p_arg_count + 1, nullptr);
+
+	Error err = (Error)Pandemonium::api->pandemonium_variant_as_int(&result);
+	Pandemonium::api->pandemonium_variant_destroy(&result);
+
+	for (int i = 0; i <= p_arg_count; i++) {
+		Pandemonium::api->pandemonium_variant_destroy(&p_args[i]);
+	}
+
+	return err;
+}
@@ -0,0 +1,82 @@
+/*************************************************************************/
+/*  signal_handle.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SIGNAL_HANDLE_H
+#define SIGNAL_HANDLE_H
+
+#include <new>
+
+#include "defs.h"
+#include "string_name.h"
+#include "variant.h"
+#include "wrapped.h"
+
+// A signal emitted from native code, to be kept as a static:
+//
+//	static SignalHandle hit("hit");
+//	hit.emit(this, damage, position);
+//
+// The name is interned once and passed to the engine as a StringName, so it is
+// not looked up from a String on every emission. Arguments are boxed straight
+// into the call buffer, without the temporary Array of the varargs wrapper.
+class SignalHandle {
+	mutable StaticStringName _name;
+
+	// Boxes the name into p_args[0], makes the call and destroys the p_arg_count + 1 variants.
+	static Error _emit(pandemonium_object *p_owner, const StringName &p_name, pandemonium_variant *p_args, const pandemonium_variant **p_ptrs, int p_arg_count);
+
+public:
+	_FORCE_INLINE_ const StringName &get_name() const {
+		return _name.get();
+	}
+
+	template <class... Args>
+	Error emit(const _Wrapped *p_object, const Args &...p_args) const {
+		ERR_FAIL_NULL_V(p_object, ERR_INVALID_PARAMETER);
+
+		// The first slot is for the name, which _emit() boxes.
+		pandemonium_variant args[sizeof...(Args) + 1];
+		const pandemonium_variant *ptrs[sizeof...(Args) + 1];
+		int i = 1;
+		int expand[] = { 0, ((void)new (&args[i++]) Variant(p_args), 0)... };
+		(void)expand;
+
+		for (i = 0; i <= (int)sizeof...(Args); i++) {
+			ptrs[i] = &args[i];
+		}
+
+		return _emit(p_object->_owner, get_name(), args, ptrs, sizeof...(Args));
+	}
+
+	explicit SignalHandle(const char *p_name) :
+			_name(p_name) {}
+};
+
+#endif // SIGNAL_HANDLE_H
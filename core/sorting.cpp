@@ -0,0 +1,166 @@
+/*************************************************************************/
+/*  sorting.cpp                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "sorting.h"
+
+int Sorting::_parallel_chunks(int p_len) {
+#ifdef SORTING_NO_THREADS
+	return 1;
+#else
+	if (p_len < PARALLEL_THRESHOLD) {
+		return 1;
+	}
+
+	const int threads = MIN((int)std::thread::hardware_concurrency(), (int)PARALLEL_MAX_THREADS);
+
+	int chunks = 1;
+	while (chunks * 2 <= threads && p_len / (chunks * 2) >= PARALLEL_MIN_CHUNK) {
+		chunks *= 2;
+	}
+
+	return chunks;
+#endif
+}
+
+// LSD radix sort on 8 bit digits. Digits where every key falls in the same
+// bucket are skipped, so narrow ranges cost fewer passes.
+static void _radix_sort_u32(uint32_t *p_data, int p_len) {
+	uint32_t *scratch = (uint32_t *)memalloc(p_len * sizeof(uint32_t));
+	ERR_FAIL_NULL(scratch);
+
+	uint32_t counts[4][256];
+	memset(counts, 0, sizeof(counts));
+
+	for (int i = 0; i < p_len; i++) {
+		const uint32_t key = p_data[i];
+		counts[0][key & 0xFF]++;
+		counts[1][(key >> 8) & 0xFF]++;
+		counts[2][(key >> 16) & 0xFF]++;
+		counts[3][key >> 24]++;
+	}
+
+	uint32_t *src = p_data;
+	uint32_t *dst = scratch;
+
+	for (int pass = 0; pass < 4; pass++) {
+		uint32_t *count = counts[pass];
+		const int shift = pass * 8;
+
+		if (count[(src[0] >> shift) & 0xFF] == (uint32_t)p_len) {
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (int i = 0; i < 256; i++) {
+			const uint32_t c = count[i];
+			count[i] = offset;
+			offset += c;
+		}
+
+		for (int i = 0; i < p_len; i++) {
+			const uint32_t key = src[i];
+			dst[count[(key >> shift) & 0xFF]++] = key;
+		}
+
+		SWAP(src, dst);
+	}
+
+	if (src != p_data) {
+		memcpy(p_data, src, p_len * sizeof(uint32_t));
+	}
+
+	memfree(scratch);
+}
+
+void Sorting::sort(uint8_t *p_data, int p_len) {
+	uint32_t counts[256];
+	memset(counts, 0, sizeof(counts));
+
+	for (int i = 0; i < p_len; i++) {
+		counts[p_data[i]]++;
+	}
+
+	int pos = 0;
+	for (int i = 0; i < 256; i++) {
+		memset(p_data + pos, i, counts[i]);
+		pos += counts[i];
+	}
+}
+
+void Sorting::sort(uint32_t *p_data, int p_len) {
+	if (p_len < RADIX_THRESHOLD) {
+		sort_by(p_data, p_len, _DefaultComparator<uint32_t>());
+		return;
+	}
+
+	_radix_sort_u32(p_data, p_len);
+}
+
+void Sorting::sort(int32_t *p_data, int p_len) {
+	if (p_len < RADIX_THRESHOLD) {
+		sort_by(p_data, p_len, _DefaultComparator<int32_t>());
+		return;
+	}
+
+	// Flipping the sign bit maps signed order onto unsigned order.
+	uint32_t *keys = (uint32_t *)p_data;
+	for (int i = 0; i < p_len; i++) {
+		keys[i] ^= 0x80000000u;
+	}
+
+	_radix_sort_u32(keys, p_len);
+
+	for (int i = 0; i < p_len; i++) {
+		keys[i] ^= 0x80000000u;
+	}
+}
+
+void Sorting::sort(float *p_data, int p_len) {
+	if (p_len < RADIX_THRESHOLD) {
+		sort_by(p_data, p_len, _DefaultComparator<float>());
+		return;
+	}
+
+	// IEEE 754 bits sort like integers once negative values have all their
+	// bits flipped and positive values only the sign bit. -0.0 sorts
+	// before 0.0, and NaNs end up at either end depending on their sign.
+	uint32_t *keys = (uint32_t *)p_data;
+	for (int i = 0; i < p_len; i++) {
+		const uint32_t mask = (uint32_t)((int32_t)keys[i] >> 31) | 0x80000000u;
+		keys[i] ^= mask;
+	}
+
+	_radix_sort_u32(keys, p_len);
+
+	for (int i = 0; i < p_len; i++) {
+		const uint32_t mask = ((keys[i] >> 31) - 1) | 0x80000000u;
+		keys[i] ^= mask;
+	}
+}
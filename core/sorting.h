@@ -0,0 +1,391 @@
+/*************************************************************************/
+/*  sorting.h                                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SORTING_H
+#define SORTING_H
+
+#include "defs.h"
+
+#include "array.h"
+#include "pool_arrays.h"
+#include "variant.h"
+
+#include "core/containers/search_array.h"
+#include "core/containers/sort_array.h"
+#include "core/os/memory.h"
+
+#include <string.h>
+#include <type_traits>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define SORTING_NO_THREADS
+#else
+#include <thread>
+#endif
+
+// Native sorting and searching on raw buffers, Array and the Pool*Array
+// types. Everything works on the data pointer, so the only API calls left
+// are the ones the element type makes itself to compare (Variant, String).
+// Array::sort() and Array::sort_custom() go back into the engine instead,
+// sort_custom() even calls a script method for each comparison.
+class Sorting {
+public:
+	enum {
+		// Below this many elements radix sorts fall back to introsort.
+		RADIX_THRESHOLD = 256,
+		// From this many elements, sort() on plain data switches to parallel_sort_by().
+		PARALLEL_THRESHOLD = 1 << 16,
+		PARALLEL_MIN_CHUNK = 1 << 13,
+		PARALLEL_MAX_THREADS = 16,
+		STABLE_SORT_RUN = 16,
+	};
+
+private:
+	// Elements are moved around as raw bytes, so sorting Variants or Strings
+	// does not copy and destroy references on every move. A sort only
+	// permutes the elements, so each value still ends up in exactly one slot.
+	template <class T>
+	struct _Slot {
+		alignas(T) uint8_t data[sizeof(T)];
+
+		_FORCE_INLINE_ const T &get() const { return *reinterpret_cast<const T *>(data); }
+	};
+
+	template <class T, class C>
+	struct _SlotCompare {
+		C compare;
+
+		_FORCE_INLINE_ bool operator()(const _Slot<T> &p_a, const _Slot<T> &p_b) const { return compare(p_a.get(), p_b.get()); }
+	};
+
+	template <class T, class C>
+	static void _merge(const _Slot<T> *p_a, int p_a_len, const _Slot<T> *p_b, int p_b_len, _Slot<T> *r_dst, const C &p_compare) {
+		int i = 0;
+		int j = 0;
+		int k = 0;
+
+		while (i < p_a_len && j < p_b_len) {
+			// Takes from the left run on ties, which keeps the merge stable.
+			if (p_compare(p_b[j].get(), p_a[i].get())) {
+				r_dst[k++] = p_b[j++];
+			} else {
+				r_dst[k++] = p_a[i++];
+			}
+		}
+
+		memcpy(r_dst + k, p_a + i, (p_a_len - i) * sizeof(_Slot<T>));
+		k += p_a_len - i;
+		memcpy(r_dst + k, p_b + j, (p_b_len - j) * sizeof(_Slot<T>));
+	}
+
+	// Bottom-up merge sort: insertion sorted runs, then merges going back
+	// and forth between p_data and p_scratch.
+	template <class T, class C>
+	static void _stable_sort(_Slot<T> *p_data, _Slot<T> *p_scratch, int p_len, const C &p_compare) {
+		for (int start = 0; start < p_len; start += STABLE_SORT_RUN) {
+			const int end = MIN(start + (int)STABLE_SORT_RUN, p_len);
+			for (int i = start + 1; i < end; i++) {
+				_Slot<T> value = p_data[i];
+				int j = i;
+				while (j > start && p_compare(value.get(), p_data[j - 1].get())) {
+					p_data[j] = p_data[j - 1];
+					j--;
+				}
+				p_data[j] = value;
+			}
+		}
+
+		_Slot<T> *src = p_data;
+		_Slot<T> *dst = p_scratch;
+		for (int width = STABLE_SORT_RUN; width < p_len; width *= 2) {
+			for (int lo = 0; lo < p_len; lo += 2 * width) {
+				const int mid = MIN(lo + width, p_len);
+				const int hi = MIN(lo + 2 * width, p_len);
+				_merge<T>(src + lo, mid - lo, src + mid, hi - mid, dst + lo, p_compare);
+			}
+			SWAP(src, dst);
+		}
+
+		if (src != p_data) {
+			memcpy(p_data, src, p_len * sizeof(_Slot<T>));
+		}
+	}
+
+	static int _parallel_chunks(int p_len);
+
+public:
+	/* Raw buffers */
+
+	template <class T, class C>
+	static void sort_by(T *p_data, int p_len, const C &p_compare) {
+		SortArray<_Slot<T>, _SlotCompare<T, C>> sorter = { { p_compare } };
+		sorter.sort(reinterpret_cast<_Slot<T> *>(p_data), p_len);
+	}
+
+	template <class T>
+	static void sort(T *p_data, int p_len) {
+		// Only plain data is sorted on several threads, comparing anything
+		// else may call into the engine.
+		if (std::is_trivially_copyable<T>::value && p_len >= PARALLEL_THRESHOLD) {
+			parallel_sort_by(p_data, p_len, _DefaultComparator<T>());
+		} else {
+			sort_by(p_data, p_len, _DefaultComparator<T>());
+		}
+	}
+
+	// Radix sorts, used by sort() for the matching pool arrays.
+	static void sort(uint8_t *p_data, int p_len);
+	static void sort(int32_t *p_data, int p_len);
+	static void sort(uint32_t *p_data, int p_len);
+	static void sort(float *p_data, int p_len);
+
+	template <class T, class C>
+	static void stable_sort_by(T *p_data, int p_len, const C &p_compare) {
+		if (p_len < 2) {
+			return;
+		}
+
+		_Slot<T> *scratch = (_Slot<T> *)memalloc(p_len * sizeof(_Slot<T>));
+		ERR_FAIL_NULL(scratch);
+		_stable_sort<T>(reinterpret_cast<_Slot<T> *>(p_data), scratch, p_len, p_compare);
+		memfree(scratch);
+	}
+
+	template <class T>
+	static void stable_sort(T *p_data, int p_len) {
+		stable_sort_by(p_data, p_len, _DefaultComparator<T>());
+	}
+
+	// Stable merge sort split over up to PARALLEL_MAX_THREADS threads for
+	// large inputs. p_compare is called from several threads at once.
+	template <class T, class C>
+	static void parallel_sort_by(T *p_data, int p_len, const C &p_compare) {
+		const int chunks = _parallel_chunks(p_len);
+		if (chunks < 2) {
+			stable_sort_by(p_data, p_len, p_compare);
+			return;
+		}
+
+#ifndef SORTING_NO_THREADS
+		_Slot<T> *data = reinterpret_cast<_Slot<T> *>(p_data);
+		_Slot<T> *scratch = (_Slot<T> *)memalloc(p_len * sizeof(_Slot<T>));
+		ERR_FAIL_NULL(scratch);
+
+		int bounds[PARALLEL_MAX_THREADS + 1];
+		for (int i = 0; i <= chunks; i++) {
+			bounds[i] = (int)((int64_t)p_len * i / chunks);
+		}
+
+		std::thread threads[PARALLEL_MAX_THREADS];
+
+		for (int i = 1; i < chunks; i++) {
+			threads[i] = std::thread([=]() {
+				_stable_sort<T>(data + bounds[i], scratch + bounds[i], bounds[i + 1] - bounds[i], p_compare);
+			});
+		}
+		_stable_sort<T>(data, scratch, bounds[1], p_compare);
+		for (int i = 1; i < chunks; i++) {
+			threads[i].join();
+		}
+
+		// Chunks is a power of two, each round merges pairs of sorted runs.
+		_Slot<T> *src = data;
+		_Slot<T> *dst = scratch;
+		for (int step = 1; step < chunks; step *= 2) {
+			for (int i = 2 * step; i < chunks; i += 2 * step) {
+				threads[i] = std::thread([=]() {
+					_merge<T>(src + bounds[i], bounds[i + step] - bounds[i], src + bounds[i + step], bounds[i + 2 * step] - bounds[i + step], dst + bounds[i], p_compare);
+				});
+			}
+			_merge<T>(src, bounds[step], src + bounds[step], bounds[2 * step] - bounds[step], dst, p_compare);
+			for (int i = 2 * step; i < chunks; i += 2 * step) {
+				threads[i].join();
+			}
+			SWAP(src, dst);
+		}
+
+		if (src != data) {
+			memcpy(data, src, p_len * sizeof(_Slot<T>));
+		}
+		memfree(scratch);
+#endif
+	}
+
+	template <class T, class C>
+	static void nth_element_by(T *p_data, int p_len, int p_nth, const C &p_compare) {
+		ERR_FAIL_INDEX(p_nth, p_len);
+
+		SortArray<_Slot<T>, _SlotCompare<T, C>> sorter = { { p_compare } };
+		sorter.nth_element(0, p_len, p_nth, reinterpret_cast<_Slot<T> *>(p_data));
+	}
+
+	template <class T>
+	static void nth_element(T *p_data, int p_len, int p_nth) {
+		nth_element_by(p_data, p_len, p_nth, _DefaultComparator<T>());
+	}
+
+	// Insertion point of p_value in sorted data, before or after equal elements.
+	template <class T, class C>
+	static int bsearch_by(const T *p_data, int p_len, const T &p_value, bool p_before, const C &p_compare) {
+		SearchArray<T, C> search = { p_compare };
+		return search.bisect(p_data, p_len, p_value, p_before);
+	}
+
+	template <class T>
+	static int bsearch(const T *p_data, int p_len, const T &p_value, bool p_before = true) {
+		return bsearch_by(p_data, p_len, p_value, p_before, _DefaultComparator<T>());
+	}
+
+	/* Array */
+
+	template <class C>
+	static void sort_by(Array &p_array, const C &p_compare) {
+		const int len = p_array.size();
+		if (len > 1) {
+			sort_by(&p_array[0], len, p_compare);
+		}
+	}
+
+	static void sort(Array &p_array) {
+		sort_by(p_array, _DefaultComparator<Variant>());
+	}
+
+	template <class C>
+	static void stable_sort_by(Array &p_array, const C &p_compare) {
+		const int len = p_array.size();
+		if (len > 1) {
+			stable_sort_by(&p_array[0], len, p_compare);
+		}
+	}
+
+	static void stable_sort(Array &p_array) {
+		stable_sort_by(p_array, _DefaultComparator<Variant>());
+	}
+
+	template <class C>
+	static void nth_element_by(Array &p_array, int p_nth, const C &p_compare) {
+		const int len = p_array.size();
+		ERR_FAIL_INDEX(p_nth, len);
+		nth_element_by(&p_array[0], len, p_nth, p_compare);
+	}
+
+	static void nth_element(Array &p_array, int p_nth) {
+		nth_element_by(p_array, p_nth, _DefaultComparator<Variant>());
+	}
+
+	template <class C>
+	static int bsearch_by(const Array &p_array, const Variant &p_value, bool p_before, const C &p_compare) {
+		const int len = p_array.size();
+		if (len == 0) {
+			return 0;
+		}
+		return bsearch_by(&p_array[0], len, p_value, p_before, p_compare);
+	}
+
+	static int bsearch(const Array &p_array, const Variant &p_value, bool p_before = true) {
+		return bsearch_by(p_array, p_value, p_before, _DefaultComparator<Variant>());
+	}
+
+	/* Pool arrays, P is any of the Pool*Array types. */
+
+	template <class P, class W = typename P::Write, class C>
+	static void sort_by(P &p_pool, const C &p_compare) {
+		const int len = p_pool.size();
+		if (len > 1) {
+			W w = p_pool.write();
+			sort_by(w.ptr(), len, p_compare);
+		}
+	}
+
+	template <class P, class W = typename P::Write>
+	static void sort(P &p_pool) {
+		const int len = p_pool.size();
+		if (len > 1) {
+			W w = p_pool.write();
+			sort(w.ptr(), len);
+		}
+	}
+
+	template <class P, class W = typename P::Write, class C>
+	static void stable_sort_by(P &p_pool, const C &p_compare) {
+		const int len = p_pool.size();
+		if (len > 1) {
+			W w = p_pool.write();
+			stable_sort_by(w.ptr(), len, p_compare);
+		}
+	}
+
+	template <class P, class W = typename P::Write>
+	static void stable_sort(P &p_pool) {
+		const int len = p_pool.size();
+		if (len > 1) {
+			W w = p_pool.write();
+			stable_sort(w.ptr(), len);
+		}
+	}
+
+	template <class P, class W = typename P::Write, class C>
+	static void nth_element_by(P &p_pool, int p_nth, const C &p_compare) {
+		const int len = p_pool.size();
+		ERR_FAIL_INDEX(p_nth, len);
+		W w = p_pool.write();
+		nth_element_by(w.ptr(), len, p_nth, p_compare);
+	}
+
+	template <class P, class W = typename P::Write>
+	static void nth_element(P &p_pool, int p_nth) {
+		const int len = p_pool.size();
+		ERR_FAIL_INDEX(p_nth, len);
+		W w = p_pool.write();
+		nth_element(w.ptr(), len, p_nth);
+	}
+
+	template <class P, class R = typename P::Read, class T, class C>
+	static int bsearch_by(const P &p_pool, const T &p_value, bool p_before, const C &p_compare) {
+		const int len = p_pool.size();
+		if (len == 0) {
+			return 0;
+		}
+		R r = p_pool.read();
+		return bsearch_by(r.ptr(), len, p_value, p_before, p_compare);
+	}
+
+	template <class P, class R = typename P::Read, class T>
+	static int bsearch(const P &p_pool, const T &p_value, bool p_before = true) {
+		const int len = p_pool.size();
+		if (len == 0) {
+			return 0;
+		}
+		R r = p_pool.read();
+		return bsearch(r.ptr(), len, p_value, p_before);
+	}
+};
+
+#endif // SORTING_H
@@ -0,0 +1,135 @@
+/*************************************************************************/
+/*  string_builder.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "string_builder.h"
+
+#include "os/memory.h"
+#include "ustring.h"
+
+void StringBuilder::_grow(int p_min_capacity) {
+	int capacity = MAX(_capacity, 16);
+	while (capacity < p_min_capacity) {
+		capacity <<= 1;
+	}
+
+	char32_t *buffer = (char32_t *)memrealloc(_buffer, capacity * sizeof(char32_t));
+	CRASH_COND_MSG(!buffer, "Out of memory");
+
+	_buffer = buffer;
+	_capacity = capacity;
+}
+
+void StringBuilder::reserve(int p_capacity) {
+	if (p_capacity > _capacity) {
+		_grow(p_capacity);
+	}
+}
+
+void StringBuilder::clear() {
+	// Keeps the buffer, builders are meant to be reused.
+	_length = 0;
+}
+
+StringBuilder &StringBuilder::append(const StringView &p_view) {
+	if (p_view.empty()) {
+		return *this;
+	}
+
+	memcpy(_tail(p_view.length()), p_view.ptr(), p_view.length() * sizeof(char32_t));
+	_length += p_view.length();
+
+	return *this;
+}
+
+StringBuilder &StringBuilder::append(const Utf8StringView &p_view) {
+	// A UTF-8 sequence never decodes to more characters than it has bytes.
+	char32_t *dst = _tail(p_view.length());
+	const char *src = p_view.ptr();
+	const int len = p_view.length();
+
+	int pos = 0;
+	int count = 0;
+	while (pos < len) {
+		if ((uint8_t)src[pos] < 0x80) {
+			dst[count++] = (char32_t)src[pos++];
+		} else {
+			dst[count++] = p_view.next_char(pos);
+		}
+	}
+	_length += count;
+
+	return *this;
+}
+
+StringBuilder &StringBuilder::append(const String &p_string) {
+	return append(StringView(p_string));
+}
+
+StringBuilder &StringBuilder::append(const char *p_utf8) {
+	return append(Utf8StringView(p_utf8));
+}
+
+StringBuilder &StringBuilder::append_int(int64_t p_num, int p_base, bool p_capitalize_hex) {
+	_length += String::num_int64_to_buffer(p_num, _tail(String::NUM_INT64_MAX_CHARS), p_base, p_capitalize_hex);
+	return *this;
+}
+
+StringBuilder &StringBuilder::append_float(double p_num, int p_decimals) {
+	_length += String::num_to_buffer(p_num, _tail(String::NUM_MAX_CHARS), p_decimals);
+	return *this;
+}
+
+StringBuilder &StringBuilder::append_hex(const uint8_t *p_buffer, int p_len) {
+	_length += String::hex_encode_to_buffer(p_buffer, p_len, _tail(p_len * 2));
+	return *this;
+}
+
+SmallString StringBuilder::as_utf8() const {
+	return SmallString(as_view());
+}
+
+String StringBuilder::as_string() const {
+	return as_view().to_string();
+}
+
+StringBuilder::StringBuilder(int p_capacity) :
+		_buffer(nullptr),
+		_length(0),
+		_capacity(0) {
+	if (p_capacity > 0) {
+		_grow(p_capacity);
+	}
+}
+
+StringBuilder::~StringBuilder() {
+	if (_buffer) {
+		memfree(_buffer);
+	}
+}
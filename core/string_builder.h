@@ -0,0 +1,98 @@
+/*************************************************************************/
+/*  string_builder.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef STRING_BUILDER_H
+#define STRING_BUILDER_H
+
+#include "defs.h"
+
+#include "string_view.h"
+
+class String;
+
+// Accumulates text in a native UTF-32 buffer and creates the engine
+// String only once, in as_string(). Use it instead of repeated
+// String::operator+=, which reallocates the whole string on every step.
+class StringBuilder {
+	char32_t *_buffer;
+	int _length;
+	int _capacity;
+
+	void _grow(int p_min_capacity);
+
+	// Returns room for p_count more characters at the end of the buffer.
+	_FORCE_INLINE_ char32_t *_tail(int p_count) {
+		if (unlikely(_length + p_count > _capacity)) {
+			_grow(_length + p_count);
+		}
+		return _buffer + _length;
+	}
+
+	StringBuilder(const StringBuilder &p_from);
+	StringBuilder &operator=(const StringBuilder &p_from);
+
+public:
+	_FORCE_INLINE_ int length() const { return _length; }
+	_FORCE_INLINE_ bool empty() const { return _length == 0; }
+	_FORCE_INLINE_ int get_capacity() const { return _capacity; }
+
+	void reserve(int p_capacity);
+	void clear();
+
+	_FORCE_INLINE_ StringBuilder &append(char32_t p_char) {
+		*_tail(1) = p_char;
+		_length++;
+		return *this;
+	}
+
+	StringBuilder &append(const StringView &p_view);
+	StringBuilder &append(const Utf8StringView &p_view);
+	StringBuilder &append(const String &p_string);
+	StringBuilder &append(const char *p_utf8);
+
+	StringBuilder &append_int(int64_t p_num, int p_base = 10, bool p_capitalize_hex = false);
+	StringBuilder &append_float(double p_num, int p_decimals = -1);
+	StringBuilder &append_hex(const uint8_t *p_buffer, int p_len);
+
+	template <class T>
+	_FORCE_INLINE_ StringBuilder &operator+=(const T &p_value) {
+		return append(p_value);
+	}
+
+	// UTF-32 contents, valid until the next append.
+	_FORCE_INLINE_ StringView as_view() const { return StringView(_buffer, _length); }
+	SmallString as_utf8() const;
+	String as_string() const;
+
+	StringBuilder(int p_capacity = 0);
+	~StringBuilder();
+};
+
+#endif // STRING_BUILDER_H
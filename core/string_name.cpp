@@ -32,26 +32,57 @@
 
 #include "array.h"
 #include "node_path.h"
+#include "os/spin_lock.h"
 #include "pandemonium_global.h"
 #include "pool_arrays.h"
 #include "variant.h"
 
 #include <gdn/string.h>
 
+#include <new>
 #include <string.h>
 
-StringName::StringName() {
+StringName::StringName() :
+		_hash(0) {
 	Pandemonium::api->pandemonium_string_name_new(&_pandemonium_string_name);
 }
 
-StringName::StringName(const char *contents) {
+StringName::StringName(const char *contents) :
+		_hash(0) {
 	Pandemonium::api->pandemonium_string_name_new_data_char(&_pandemonium_string_name, contents);
 }
 
-StringName::StringName(const String &other) {
+StringName::StringName(const String &other) :
+		_hash(0) {
 	Pandemonium::api->pandemonium_string_name_new_data_string(&_pandemonium_string_name, &other._pandemonium_string);
 }
 
+// The API has no string_name copy, but a Variant round trip only takes
+// another reference to the interned data, without hashing or looking the
+// name up in the engine's table.
+StringName::StringName(const StringName &other) :
+		_hash(other._hash.load(std::memory_order_relaxed)) {
+	pandemonium_variant v;
+	Pandemonium::api->pandemonium_variant_new_string_name(&v, &other._pandemonium_string_name);
+	_pandemonium_string_name = Pandemonium::api->pandemonium_variant_as_string_name(&v);
+	Pandemonium::api->pandemonium_variant_destroy(&v);
+}
+
+StringName &StringName::operator=(const StringName &other) {
+	if (this == &other) {
+		return *this;
+	}
+
+	pandemonium_variant v;
+	Pandemonium::api->pandemonium_variant_new_string_name(&v, &other._pandemonium_string_name);
+	Pandemonium::api->pandemonium_string_name_destroy(&_pandemonium_string_name);
+	_pandemonium_string_name = Pandemonium::api->pandemonium_variant_as_string_name(&v);
+	Pandemonium::api->pandemonium_variant_destroy(&v);
+	_hash.store(other._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+	return *this;
+}
+
 StringName::~StringName() {
 	Pandemonium::api->pandemonium_string_name_destroy(&_pandemonium_string_name);
 }
@@ -61,16 +92,26 @@ StringName::operator String() {
 }
 
 uint32_t StringName::get_hash() {
-	return Pandemonium::api->pandemonium_string_name_get_hash(&_pandemonium_string_name);
+	return hash();
 }
 uint32_t StringName::hash() const {
-	return Pandemonium::api->pandemonium_string_name_get_hash(&_pandemonium_string_name);
+	uint32_t h = _hash.load(std::memory_order_relaxed);
+	if (h == 0) {
+		h = Pandemonium::api->pandemonium_string_name_get_hash(&_pandemonium_string_name);
+		_hash.store(h, std::memory_order_relaxed);
+	}
+	return h;
 }
 const void *StringName::get_data_unique_pointer() {
 	return &_pandemonium_string_name;
 }
 
 bool StringName::operator==(const StringName &s) const {
+	const uint32_t h = _hash.load(std::memory_order_relaxed);
+	const uint32_t s_h = s._hash.load(std::memory_order_relaxed);
+	if (h != 0 && s_h != 0 && h != s_h) {
+		return false;
+	}
 	return Pandemonium::api->pandemonium_string_name_operator_equal(&_pandemonium_string_name, &s._pandemonium_string_name);
 }
 
@@ -94,3 +135,42 @@ bool StringName::operator>(const StringName &s) const {
 bool StringName::operator>=(const StringName &s) const {
 	return !(*this < s);
 }
+
+static SpinLock static_string_name_lock;
+static StaticStringName *static_string_name_list = nullptr;
+
+StringName *StaticStringName::_intern() {
+	static_string_name_lock.lock();
+
+	StringName *name = _name.load(std::memory_order_relaxed);
+	if (!name) {
+		name = new (_storage) StringName(_literal);
+		name->hash();
+
+		_next = static_string_name_list;
+		static_string_name_list = this;
+		_name.store(name, std::memory_order_release);
+	}
+
+	static_string_name_lock.unlock();
+
+	return name;
+}
+
+void StaticStringName::cleanup() {
+	static_string_name_lock.lock();
+
+	StaticStringName *sname = static_string_name_list;
+	while (sname) {
+		StaticStringName *next = sname->_next;
+
+		sname->_name.load(std::memory_order_relaxed)->~StringName();
+		sname->_name.store(nullptr, std::memory_order_relaxed);
+		sname->_next = nullptr;
+
+		sname = next;
+	}
+	static_string_name_list = nullptr;
+
+	static_string_name_lock.unlock();
+}
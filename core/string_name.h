@@ -33,21 +33,31 @@
 
 #include <gdn/string_name.h>
 
+#include "defs.h"
+
+#include <atomic>
+
 class String;
 
 class StringName {
 	pandemonium_string_name _pandemonium_string_name;
+	// Engine hash of the name, 0 until first requested. Shared names such as
+	// SNAME() are hashed from any thread, every writer stores the same value.
+	mutable std::atomic<uint32_t> _hash;
 
 	friend class Dictionary;
 	friend class NodePath;
 	friend class Variant;
 	explicit inline StringName(pandemonium_string_name contents) :
-			_pandemonium_string_name(contents) {}
+			_pandemonium_string_name(contents),
+			_hash(0) {}
 
 public:
 	StringName();
 	StringName(const char *contents);
 	StringName(const String &other);
+	StringName(const StringName &other);
+	StringName &operator=(const StringName &other);
 
 	~StringName();
 
@@ -66,4 +76,37 @@ public:
 	bool operator>=(const StringName &s) const;
 };
 
-#endif // STRING_H
+// Lazily interned StringName for a string literal, see SNAME().
+// Instances are expected to have static storage duration. The name is
+// created on first use and released by cleanup() when the library is
+// terminated, so no engine call happens during static destruction.
+class StaticStringName {
+	const char *_literal;
+	std::atomic<StringName *> _name;
+	StaticStringName *_next;
+	alignas(StringName) uint8_t _storage[sizeof(StringName)];
+
+	StringName *_intern();
+
+public:
+	_FORCE_INLINE_ const StringName &get() {
+		StringName *name = _name.load(std::memory_order_acquire);
+		if (unlikely(!name)) {
+			name = _intern();
+		}
+		return *name;
+	}
+
+	static void cleanup();
+
+	explicit StaticStringName(const char *p_literal) :
+			_literal(p_literal),
+			_name(nullptr),
+			_next(nullptr) {}
+};
+
+// Resolves a string literal to a StringName once per call site; later
+// evaluations return the same handle with its hash already cached.
+#define SNAME(m_name) ([]() -> const StringName & { static StaticStringName sname(m_name); return sname.get(); })()
+
+#endif // STRING_NAME_H
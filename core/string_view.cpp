@@ -0,0 +1,749 @@
+/*************************************************************************/
+/*  string_view.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "string_view.h"
+
+#include "os/memory.h"
+#include "pandemonium_global.h"
+#include "ustring.h"
+
+#include <gdn/string.h>
+
+#include <wchar.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_VIEW_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Text up to this many bytes is converted to a String through a stack buffer.
+#define STRING_VIEW_STACK_BUFFER 256
+
+static _FORCE_INLINE_ int _lowest_bit(uint32_t p_mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, p_mask);
+	return (int)index;
+#else
+	return __builtin_ctz(p_mask);
+#endif
+}
+
+/* Search kernels */
+
+static int _find_char32(const char32_t *p_data, int p_length, int p_from, char32_t p_char) {
+	int i = p_from;
+
+#ifdef STRING_VIEW_SSE2
+	const __m128i needle = _mm_set1_epi32((int)p_char);
+	for (; i + 4 <= p_length; i += 4) {
+		__m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_data + i)), needle);
+		int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+		if (mask) {
+			return i + _lowest_bit(mask);
+		}
+	}
+#endif
+
+	for (; i < p_length; i++) {
+		if (p_data[i] == p_char) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+// Candidates are positions where both the first and the last character of
+// the needle match, only those get a full compare.
+static int _find_seq32(const char32_t *p_data, int p_length, int p_from, const char32_t *p_what, int p_what_length) {
+	if (p_what_length == 1) {
+		return _find_char32(p_data, p_length, p_from, p_what[0]);
+	}
+
+	const int last_start = p_length - p_what_length;
+	const char32_t first = p_what[0];
+	const char32_t last = p_what[p_what_length - 1];
+	const size_t middle = (p_what_length - 2) * sizeof(char32_t);
+	int i = p_from;
+
+#ifdef STRING_VIEW_SSE2
+	const __m128i first_v = _mm_set1_epi32((int)first);
+	const __m128i last_v = _mm_set1_epi32((int)last);
+	for (; i + 3 <= last_start; i += 4) {
+		__m128i eq_first = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_data + i)), first_v);
+		__m128i eq_last = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_data + i + p_what_length - 1)), last_v);
+		uint32_t mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(eq_first, eq_last)));
+		while (mask) {
+			int at = i + _lowest_bit(mask);
+			if (memcmp(p_data + at + 1, p_what + 1, middle) == 0) {
+				return at;
+			}
+			mask &= mask - 1;
+		}
+	}
+#endif
+
+	for (; i <= last_start; i++) {
+		if (p_data[i] == first && p_data[i + p_what_length - 1] == last && memcmp(p_data + i + 1, p_what + 1, middle) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static int _find_char8(const char *p_data, int p_length, int p_from, char p_char) {
+	// The C library memchr is already vectorized everywhere that matters.
+	const void *found = memchr(p_data + p_from, p_char, p_length - p_from);
+	return found ? (int)((const char *)found - p_data) : -1;
+}
+
+static int _find_seq8(const char *p_data, int p_length, int p_from, const char *p_what, int p_what_length) {
+	if (p_what_length == 1) {
+		return _find_char8(p_data, p_length, p_from, p_what[0]);
+	}
+
+	const int last_start = p_length - p_what_length;
+	const char first = p_what[0];
+	const char last = p_what[p_what_length - 1];
+	const size_t middle = p_what_length - 2;
+	int i = p_from;
+
+#ifdef STRING_VIEW_SSE2
+	const __m128i first_v = _mm_set1_epi8(first);
+	const __m128i last_v = _mm_set1_epi8(last);
+	for (; i + 15 <= last_start; i += 16) {
+		__m128i eq_first = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p_data + i)), first_v);
+		__m128i eq_last = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p_data + i + p_what_length - 1)), last_v);
+		uint32_t mask = _mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+		while (mask) {
+			int at = i + _lowest_bit(mask);
+			if (memcmp(p_data + at + 1, p_what + 1, middle) == 0) {
+				return at;
+			}
+			mask &= mask - 1;
+		}
+	}
+#endif
+
+	for (; i <= last_start; i++) {
+		if (p_data[i] == first && p_data[i + p_what_length - 1] == last && memcmp(p_data + i + 1, p_what + 1, middle) == 0) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+// Writes the UTF-8 encoding of p_char to r_dst, which needs room for 4 bytes.
+static int _encode_utf8(char32_t p_char, char *r_dst) {
+	uint8_t *dst = (uint8_t *)r_dst;
+
+	if (p_char < 0x80) {
+		dst[0] = (uint8_t)p_char;
+		return 1;
+	} else if (p_char < 0x800) {
+		dst[0] = (uint8_t)(0xC0 | (p_char >> 6));
+		dst[1] = (uint8_t)(0x80 | (p_char & 0x3F));
+		return 2;
+	} else if (p_char < 0x10000) {
+		if (p_char >= 0xD800 && p_char <= 0xDFFF) {
+			p_char = 0xFFFD;
+		}
+		dst[0] = (uint8_t)(0xE0 | (p_char >> 12));
+		dst[1] = (uint8_t)(0x80 | ((p_char >> 6) & 0x3F));
+		dst[2] = (uint8_t)(0x80 | (p_char & 0x3F));
+		return 3;
+	} else if (p_char < 0x110000) {
+		dst[0] = (uint8_t)(0xF0 | (p_char >> 18));
+		dst[1] = (uint8_t)(0x80 | ((p_char >> 12) & 0x3F));
+		dst[2] = (uint8_t)(0x80 | ((p_char >> 6) & 0x3F));
+		dst[3] = (uint8_t)(0x80 | (p_char & 0x3F));
+		return 4;
+	}
+
+	// Out of range, encode U+FFFD.
+	dst[0] = 0xEF;
+	dst[1] = 0xBF;
+	dst[2] = 0xBD;
+	return 3;
+}
+
+static String _utf8_to_string(const char *p_data, int p_length) {
+	char stack_buffer[STRING_VIEW_STACK_BUFFER];
+	char *buffer = stack_buffer;
+
+	if (p_length >= STRING_VIEW_STACK_BUFFER) {
+		buffer = (char *)memalloc(p_length + 1);
+		ERR_FAIL_NULL_V(buffer, String());
+	}
+
+	memcpy(buffer, p_data, p_length);
+	buffer[p_length] = 0;
+
+	String ret(buffer);
+
+	if (buffer != stack_buffer) {
+		memfree(buffer);
+	}
+
+	return ret;
+}
+
+/* Utf8Encoder */
+
+static _FORCE_INLINE_ int _utf8_size(char32_t p_char) {
+	if (p_char < 0x80) {
+		return 1;
+	} else if (p_char < 0x800) {
+		return 2;
+	} else if (p_char < 0x10000 || p_char >= 0x110000) {
+		return 3;
+	}
+	return 4;
+}
+
+int Utf8Encoder::encoded_length(const char32_t *p_src, int p_src_length) {
+	int size = 0;
+	for (int i = 0; i < p_src_length; i++) {
+		size += _utf8_size(p_src[i]);
+	}
+	return size;
+}
+
+int Utf8Encoder::encode(const char32_t *p_src, int p_src_length, char *r_dst, int p_dst_size, int &r_consumed) {
+	int i = 0;
+	int written = 0;
+
+	while (i < p_src_length) {
+#ifdef STRING_VIEW_SSE2
+		// ASCII runs are narrowed 8 characters at a time.
+		const __m128i high_mask = _mm_set1_epi32(~0x7F);
+		const __m128i zero = _mm_setzero_si128();
+		while (i + 8 <= p_src_length && written + 8 <= p_dst_size) {
+			__m128i a = _mm_loadu_si128((const __m128i *)(p_src + i));
+			__m128i b = _mm_loadu_si128((const __m128i *)(p_src + i + 4));
+			__m128i high = _mm_and_si128(_mm_or_si128(a, b), high_mask);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xFFFF) {
+				break;
+			}
+			_mm_storel_epi64((__m128i *)(r_dst + written), _mm_packus_epi16(_mm_packs_epi32(a, b), zero));
+			i += 8;
+			written += 8;
+		}
+		if (i == p_src_length) {
+			break;
+		}
+#endif
+
+		const char32_t c = p_src[i];
+		if (c < 0x80) {
+			if (written == p_dst_size) {
+				break;
+			}
+			r_dst[written++] = (char)c;
+		} else {
+			if (written + _utf8_size(c) > p_dst_size) {
+				break;
+			}
+			written += _encode_utf8(c, r_dst + written);
+		}
+		i++;
+	}
+
+	r_consumed = i;
+	return written;
+}
+
+/* Utf8ScratchString */
+
+Utf8ScratchString::Utf8ScratchString(const StringView &p_view) :
+		_data(_stack),
+		_length(0) {
+	int consumed;
+	_length = Utf8Encoder::encode(p_view.ptr(), p_view.length(), _stack, STACK_SIZE - 1, consumed);
+
+	if (consumed < p_view.length()) {
+		const char32_t *rest = p_view.ptr() + consumed;
+		const int rest_length = p_view.length() - consumed;
+		const int rest_size = Utf8Encoder::encoded_length(rest, rest_length);
+
+		// No error macros here, this is used to print errors.
+		char *data = (char *)memalloc(_length + rest_size + 1);
+		if (data) {
+			memcpy(data, _stack, _length);
+			_length += Utf8Encoder::encode(rest, rest_length, data + _length, rest_size, consumed);
+			_data = data;
+		}
+	}
+
+	_data[_length] = 0;
+}
+
+Utf8ScratchString::~Utf8ScratchString() {
+	if (_data != _stack) {
+		memfree(_data);
+	}
+}
+
+/* StringView */
+
+StringView StringView::substr(int p_from, int p_len) const {
+	ERR_FAIL_INDEX_V(p_from, _length + 1, StringView());
+
+	if (p_len < 0 || p_from + p_len > _length) {
+		p_len = _length - p_from;
+	}
+
+	return StringView(_data + p_from, p_len);
+}
+
+int StringView::find_char(char32_t p_char, int p_from) const {
+	p_from = MAX(p_from, 0);
+	if (p_from >= _length) {
+		return -1;
+	}
+
+	return _find_char32(_data, _length, p_from, p_char);
+}
+
+int StringView::rfind_char(char32_t p_char, int p_from) const {
+	if (p_from < 0 || p_from >= _length) {
+		p_from = _length - 1;
+	}
+
+	for (int i = p_from; i >= 0; i--) {
+		if (_data[i] == p_char) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int StringView::find(const StringView &p_what, int p_from) const {
+	p_from = MAX(p_from, 0);
+	if (p_what._length == 0 || p_from + p_what._length > _length) {
+		return -1;
+	}
+
+	return _find_seq32(_data, _length, p_from, p_what._data, p_what._length);
+}
+
+bool StringView::begins_with(const StringView &p_prefix) const {
+	if (p_prefix._length > _length) {
+		return false;
+	}
+
+	return memcmp(_data, p_prefix._data, p_prefix._length * sizeof(char32_t)) == 0;
+}
+
+bool StringView::ends_with(const StringView &p_suffix) const {
+	if (p_suffix._length > _length) {
+		return false;
+	}
+
+	return memcmp(_data + _length - p_suffix._length, p_suffix._data, p_suffix._length * sizeof(char32_t)) == 0;
+}
+
+bool StringView::operator==(const StringView &p_view) const {
+	if (_length != p_view._length) {
+		return false;
+	}
+
+	return _data == p_view._data || memcmp(_data, p_view._data, _length * sizeof(char32_t)) == 0;
+}
+
+bool StringView::operator<(const StringView &p_view) const {
+	const int len = MIN(_length, p_view._length);
+
+	for (int i = 0; i < len; i++) {
+		if (_data[i] != p_view._data[i]) {
+			return _data[i] < p_view._data[i];
+		}
+	}
+
+	return _length < p_view._length;
+}
+
+uint32_t StringView::hash() const {
+	uint32_t hashv = 5381;
+
+	for (int i = 0; i < _length; i++) {
+		hashv = ((hashv << 5) + hashv) + _data[i]; /* hash * 33 + c */
+	}
+
+	return hashv;
+}
+
+String StringView::to_string() const {
+	if (_length == 0) {
+		return String();
+	}
+
+#if WCHAR_MAX > 0xFFFF
+	// wchar_t is UTF-32 here, the engine can copy the buffer as is.
+	pandemonium_string str;
+	Pandemonium::api->pandemonium_string_new_wchar_clip_to_len(&str, (const wchar_t *)_data, _length);
+	return String(str);
+#else
+	SmallString utf8(*this);
+	return utf8.to_string();
+#endif
+}
+
+StringView::StringView(const char32_t *p_cstr) :
+		_data(p_cstr),
+		_length(0) {
+	if (p_cstr) {
+		while (p_cstr[_length]) {
+			_length++;
+		}
+	}
+}
+
+StringView::StringView(const String &p_string) :
+		_data(p_string.unicode_str()),
+		_length(p_string.length()) {
+}
+
+/* Utf8StringView */
+
+char32_t Utf8StringView::next_char(int &r_pos) const {
+	ERR_FAIL_INDEX_V(r_pos, _length, 0);
+
+	const uint8_t *s = (const uint8_t *)_data + r_pos;
+	const int available = _length - r_pos;
+	const uint8_t lead = s[0];
+
+	int size;
+	char32_t c;
+	char32_t min;
+
+	if (lead < 0x80) {
+		r_pos++;
+		return lead;
+	} else if ((lead & 0xE0) == 0xC0) {
+		size = 2;
+		c = lead & 0x1F;
+		min = 0x80;
+	} else if ((lead & 0xF0) == 0xE0) {
+		size = 3;
+		c = lead & 0x0F;
+		min = 0x800;
+	} else if ((lead & 0xF8) == 0xF0) {
+		size = 4;
+		c = lead & 0x07;
+		min = 0x10000;
+	} else {
+		r_pos++;
+		return 0xFFFD;
+	}
+
+	if (size > available) {
+		r_pos++;
+		return 0xFFFD;
+	}
+
+	for (int i = 1; i < size; i++) {
+		if ((s[i] & 0xC0) != 0x80) {
+			r_pos++;
+			return 0xFFFD;
+		}
+		c = (c << 6) | (s[i] & 0x3F);
+	}
+
+	if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+		r_pos++;
+		return 0xFFFD;
+	}
+
+	r_pos += size;
+	return c;
+}
+
+Utf8StringView Utf8StringView::substr(int p_from, int p_len) const {
+	ERR_FAIL_INDEX_V(p_from, _length + 1, Utf8StringView());
+
+	if (p_len < 0 || p_from + p_len > _length) {
+		p_len = _length - p_from;
+	}
+
+	return Utf8StringView(_data + p_from, p_len);
+}
+
+int Utf8StringView::find_char(char p_char, int p_from) const {
+	p_from = MAX(p_from, 0);
+	if (p_from >= _length) {
+		return -1;
+	}
+
+	return _find_char8(_data, _length, p_from, p_char);
+}
+
+int Utf8StringView::rfind_char(char p_char, int p_from) const {
+	if (p_from < 0 || p_from >= _length) {
+		p_from = _length - 1;
+	}
+
+	for (int i = p_from; i >= 0; i--) {
+		if (_data[i] == p_char) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int Utf8StringView::find(const Utf8StringView &p_what, int p_from) const {
+	p_from = MAX(p_from, 0);
+	if (p_what._length == 0 || p_from + p_what._length > _length) {
+		return -1;
+	}
+
+	return _find_seq8(_data, _length, p_from, p_what._data, p_what._length);
+}
+
+bool Utf8StringView::begins_with(const Utf8StringView &p_prefix) const {
+	if (p_prefix._length > _length) {
+		return false;
+	}
+
+	return memcmp(_data, p_prefix._data, p_prefix._length) == 0;
+}
+
+bool Utf8StringView::ends_with(const Utf8StringView &p_suffix) const {
+	if (p_suffix._length > _length) {
+		return false;
+	}
+
+	return memcmp(_data + _length - p_suffix._length, p_suffix._data, p_suffix._length) == 0;
+}
+
+bool Utf8StringView::operator==(const Utf8StringView &p_view) const {
+	if (_length != p_view._length) {
+		return false;
+	}
+
+	return _data == p_view._data || memcmp(_data, p_view._data, _length) == 0;
+}
+
+// Byte order of valid UTF-8 is the same as code point order.
+bool Utf8StringView::operator<(const Utf8StringView &p_view) const {
+	const int len = MIN(_length, p_view._length);
+	const int cmp = memcmp(_data, p_view._data, len);
+
+	if (cmp != 0) {
+		return cmp < 0;
+	}
+
+	return _length < p_view._length;
+}
+
+uint32_t Utf8StringView::hash() const {
+	const uint8_t *chr = (const uint8_t *)_data;
+	uint32_t hashv = 5381;
+
+	for (int i = 0; i < _length; i++) {
+		hashv = ((hashv << 5) + hashv) + chr[i]; /* hash * 33 + c */
+	}
+
+	return hashv;
+}
+
+String Utf8StringView::to_string() const {
+	if (_length == 0) {
+		return String();
+	}
+
+	return _utf8_to_string(_data, _length);
+}
+
+/* SmallString */
+
+void SmallString::_reserve(int p_capacity) {
+	int capacity = MAX(_capacity, SMALL_STRING_INLINE);
+	while (capacity < p_capacity) {
+		capacity <<= 1;
+	}
+
+	if (is_inline()) {
+		char *data = (char *)memalloc(capacity + 1);
+		ERR_FAIL_NULL(data);
+		memcpy(data, _inline, _length + 1);
+		_data = data;
+	} else {
+		char *data = (char *)memrealloc(_data, capacity + 1);
+		ERR_FAIL_NULL(data);
+		_data = data;
+	}
+
+	_capacity = capacity;
+}
+
+void SmallString::clear() {
+	if (!is_inline()) {
+		memfree(_data);
+		_data = _inline;
+		_capacity = SMALL_STRING_INLINE;
+	}
+
+	_length = 0;
+	_data[0] = 0;
+}
+
+void SmallString::reserve(int p_capacity) {
+	if (p_capacity > _capacity) {
+		_reserve(p_capacity);
+	}
+}
+
+void SmallString::append(const Utf8StringView &p_view) {
+	if (p_view.empty()) {
+		return;
+	}
+
+	const char *src = p_view.ptr();
+	const int new_length = _length + p_view.length();
+	if (new_length > _capacity) {
+		// The view may point into this string, which is about to move.
+		const bool inside = src >= _data && src < _data + _length;
+		const ptrdiff_t offset = src - _data;
+
+		_reserve(new_length);
+		ERR_FAIL_COND(new_length > _capacity);
+
+		if (inside) {
+			src = _data + offset;
+		}
+	}
+
+	// memmove, the view may point into this string.
+	memmove(_data + _length, src, p_view.length());
+	_length = new_length;
+	_data[_length] = 0;
+}
+
+void SmallString::append(char p_char) {
+	if (_length + 1 > _capacity) {
+		_reserve(_length + 1);
+		ERR_FAIL_COND(_length + 1 > _capacity);
+	}
+
+	_data[_length++] = p_char;
+	_data[_length] = 0;
+}
+
+void SmallString::append_char32(char32_t p_char) {
+	char buffer[4];
+	int size = _encode_utf8(p_char, buffer);
+	append(Utf8StringView(buffer, size));
+}
+
+String SmallString::to_string() const {
+	// Always null terminated, the engine can parse the buffer in place.
+	return String(_data);
+}
+
+SmallString &SmallString::operator=(const SmallString &p_from) {
+	if (this != &p_from) {
+		_length = 0;
+		_data[0] = 0;
+		append(p_from.view());
+	}
+
+	return *this;
+}
+
+SmallString &SmallString::operator=(const Utf8StringView &p_view) {
+	if (p_view.ptr() >= _data && p_view.ptr() < _data + _length) {
+		// Assigning a part of ourselves, move it to the front.
+		memmove(_data, p_view.ptr(), p_view.length());
+		_length = p_view.length();
+		_data[_length] = 0;
+		return *this;
+	}
+
+	_length = 0;
+	_data[0] = 0;
+	append(p_view);
+
+	return *this;
+}
+
+SmallString::SmallString() :
+		_data(_inline),
+		_length(0),
+		_capacity(SMALL_STRING_INLINE) {
+	_inline[0] = 0;
+}
+
+SmallString::SmallString(const char *p_cstr) :
+		SmallString() {
+	append(Utf8StringView(p_cstr));
+}
+
+SmallString::SmallString(const Utf8StringView &p_view) :
+		SmallString() {
+	append(p_view);
+}
+
+SmallString::SmallString(const StringView &p_view) :
+		SmallString() {
+	const int size = Utf8Encoder::encoded_length(p_view.ptr(), p_view.length());
+	reserve(size);
+	ERR_FAIL_COND(size > _capacity);
+
+	int consumed;
+	_length = Utf8Encoder::encode(p_view.ptr(), p_view.length(), _data, size, consumed);
+	_data[_length] = 0;
+}
+
+SmallString::SmallString(const String &p_string) :
+		SmallString() {
+	CharString utf8 = p_string.utf8();
+	append(Utf8StringView(utf8.get_data(), utf8.length()));
+}
+
+SmallString::SmallString(const SmallString &p_from) :
+		SmallString() {
+	append(p_from.view());
+}
+
+SmallString::~SmallString() {
+	if (!is_inline()) {
+		memfree(_data);
+	}
+}
@@ -0,0 +1,244 @@
+/*************************************************************************/
+/*  string_view.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef STRING_VIEW_H
+#define STRING_VIEW_H
+
+#include "defs.h"
+
+#include <string.h>
+
+class String;
+
+// Non-owning view over UTF-32 text. Building one from a String reads the
+// engine buffer once, everything afterwards runs on the raw data.
+// The view does not keep the data alive, it is invalidated by any change
+// to the String it was taken from.
+class StringView {
+	const char32_t *_data;
+	int _length;
+
+public:
+	_FORCE_INLINE_ const char32_t *ptr() const { return _data; }
+	_FORCE_INLINE_ int length() const { return _length; }
+	_FORCE_INLINE_ bool empty() const { return _length == 0; }
+
+	_FORCE_INLINE_ char32_t operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, _length);
+		return _data[p_index];
+	}
+
+	StringView substr(int p_from, int p_len = -1) const;
+
+	int find_char(char32_t p_char, int p_from = 0) const;
+	int rfind_char(char32_t p_char, int p_from = -1) const;
+	int find(const StringView &p_what, int p_from = 0) const;
+
+	bool begins_with(const StringView &p_prefix) const;
+	bool ends_with(const StringView &p_suffix) const;
+
+	bool operator==(const StringView &p_view) const;
+	_FORCE_INLINE_ bool operator!=(const StringView &p_view) const { return !(*this == p_view); }
+	bool operator<(const StringView &p_view) const;
+
+	// Same value as String::hash() for the same text.
+	uint32_t hash() const;
+
+	String to_string() const;
+
+	_FORCE_INLINE_ StringView() :
+			_data(nullptr),
+			_length(0) {}
+	_FORCE_INLINE_ StringView(const char32_t *p_data, int p_length) :
+			_data(p_data),
+			_length(p_length) {}
+	StringView(const char32_t *p_cstr);
+	StringView(const String &p_string);
+};
+
+// Non-owning view over UTF-8 bytes, for text that comes from files,
+// sockets or literals and doesn't need to go through a String at all.
+// Searching and indexing work on bytes; use next_char() to walk code points.
+class Utf8StringView {
+	const char *_data;
+	int _length;
+
+public:
+	_FORCE_INLINE_ const char *ptr() const { return _data; }
+	_FORCE_INLINE_ int length() const { return _length; }
+	_FORCE_INLINE_ bool empty() const { return _length == 0; }
+
+	_FORCE_INLINE_ char operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, _length);
+		return _data[p_index];
+	}
+
+	// Decodes the code point at r_pos and advances r_pos past it.
+	// Malformed sequences decode to U+FFFD one byte at a time.
+	char32_t next_char(int &r_pos) const;
+
+	Utf8StringView substr(int p_from, int p_len = -1) const;
+
+	int find_char(char p_char, int p_from = 0) const;
+	int rfind_char(char p_char, int p_from = -1) const;
+	int find(const Utf8StringView &p_what, int p_from = 0) const;
+
+	bool begins_with(const Utf8StringView &p_prefix) const;
+	bool ends_with(const Utf8StringView &p_suffix) const;
+
+	bool operator==(const Utf8StringView &p_view) const;
+	_FORCE_INLINE_ bool operator!=(const Utf8StringView &p_view) const { return !(*this == p_view); }
+	bool operator<(const Utf8StringView &p_view) const;
+
+	uint32_t hash() const;
+
+	String to_string() const;
+
+	_FORCE_INLINE_ Utf8StringView() :
+			_data(nullptr),
+			_length(0) {}
+	_FORCE_INLINE_ Utf8StringView(const char *p_data, int p_length) :
+			_data(p_data),
+			_length(p_length) {}
+	_FORCE_INLINE_ Utf8StringView(const char *p_cstr) :
+			_data(p_cstr),
+			_length(p_cstr ? (int)strlen(p_cstr) : 0) {}
+};
+
+// Streaming UTF-32 to UTF-8 conversion into caller owned memory.
+class Utf8Encoder {
+public:
+	// Exact number of bytes encode() produces for the whole input.
+	static int encoded_length(const char32_t *p_src, int p_src_length);
+
+	// Encodes as much of p_src as fits in p_dst_size bytes, without splitting
+	// a character, and returns the number of bytes written. r_consumed is set
+	// to the number of characters encoded, so the caller can continue with
+	// the rest once it has made room. Nothing is null terminated. Surrogates
+	// and values past U+10FFFF are replaced with U+FFFD.
+	static int encode(const char32_t *p_src, int p_src_length, char *r_dst, int p_dst_size, int &r_consumed);
+};
+
+// Null terminated UTF-8 copy of some text for a single engine call, kept on
+// the stack unless it is long. Replaces the String::utf8() / CharString
+// round trip, which allocates twice.
+class Utf8ScratchString {
+	enum {
+		STACK_SIZE = 256,
+	};
+
+	char *_data;
+	int _length;
+	char _stack[STACK_SIZE];
+
+	Utf8ScratchString(const Utf8ScratchString &p_from);
+	Utf8ScratchString &operator=(const Utf8ScratchString &p_from);
+
+public:
+	_FORCE_INLINE_ const char *get_data() const { return _data; }
+	_FORCE_INLINE_ int length() const { return _length; }
+
+	explicit Utf8ScratchString(const StringView &p_view);
+	~Utf8ScratchString();
+};
+
+// Owning UTF-8 string that keeps short text inline and only allocates
+// once it grows past SMALL_STRING_INLINE bytes. The data is always
+// null terminated, so handing it to the engine is a single parse.
+class SmallString {
+public:
+	enum {
+		SMALL_STRING_INLINE = 31,
+	};
+
+private:
+	char *_data;
+	int _length;
+	int _capacity;
+	char _inline[SMALL_STRING_INLINE + 1];
+
+	void _reserve(int p_capacity);
+
+public:
+	_FORCE_INLINE_ const char *ptr() const { return _data; }
+	_FORCE_INLINE_ const char *get_data() const { return _data; }
+	_FORCE_INLINE_ int length() const { return _length; }
+	_FORCE_INLINE_ bool empty() const { return _length == 0; }
+	_FORCE_INLINE_ bool is_inline() const { return _data == _inline; }
+
+	_FORCE_INLINE_ char operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, _length);
+		return _data[p_index];
+	}
+
+	_FORCE_INLINE_ Utf8StringView view() const { return Utf8StringView(_data, _length); }
+	_FORCE_INLINE_ operator Utf8StringView() const { return view(); }
+
+	void clear();
+	void reserve(int p_capacity);
+
+	void append(const Utf8StringView &p_view);
+	void append(char p_char);
+	void append_char32(char32_t p_char);
+
+	_FORCE_INLINE_ SmallString &operator+=(const Utf8StringView &p_view) {
+		append(p_view);
+		return *this;
+	}
+	_FORCE_INLINE_ SmallString &operator+=(char p_char) {
+		append(p_char);
+		return *this;
+	}
+
+	_FORCE_INLINE_ int find_char(char p_char, int p_from = 0) const { return view().find_char(p_char, p_from); }
+	_FORCE_INLINE_ int find(const Utf8StringView &p_what, int p_from = 0) const { return view().find(p_what, p_from); }
+	_FORCE_INLINE_ bool begins_with(const Utf8StringView &p_prefix) const { return view().begins_with(p_prefix); }
+	_FORCE_INLINE_ bool ends_with(const Utf8StringView &p_suffix) const { return view().ends_with(p_suffix); }
+
+	_FORCE_INLINE_ bool operator==(const Utf8StringView &p_view) const { return view() == p_view; }
+	_FORCE_INLINE_ bool operator!=(const Utf8StringView &p_view) const { return view() != p_view; }
+	_FORCE_INLINE_ bool operator<(const Utf8StringView &p_view) const { return view() < p_view; }
+	_FORCE_INLINE_ uint32_t hash() const { return view().hash(); }
+
+	String to_string() const;
+
+	SmallString &operator=(const SmallString &p_from);
+	SmallString &operator=(const Utf8StringView &p_view);
+
+	SmallString();
+	SmallString(const char *p_cstr);
+	SmallString(const Utf8StringView &p_view);
+	SmallString(const StringView &p_view);
+	SmallString(const String &p_string);
+	SmallString(const SmallString &p_from);
+	~SmallString();
+};
+
+#endif // STRING_VIEW_H
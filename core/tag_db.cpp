@@ -31,22 +31,201 @@
 #include "tag_db.h"
 
 #include "core/containers/hash_map.h"
+#include "core/containers/hashfuncs.h"
+#include "core/containers/vector.h"
+#include "core/os/memory.h"
+#include "core/os/spin_lock.h"
 
 #include <pandemonium_global.h>
 
+#include <atomic>
+
 namespace _TagDB {
 
+struct TypeRange {
+	size_t tag; // 0 for empty slots.
+	uint32_t first;
+	uint32_t last;
+};
+
+// Open addressing table of every known type. Never modified once published,
+// a new one replaces it after registrations.
+struct TypeTable {
+	TypeRange *slots;
+	uint32_t mask;
+};
+
 HashMap<size_t, size_t> parent_to;
 
+static SpinLock lock;
+static std::atomic<TypeTable *> table(nullptr);
+static std::atomic<bool> dirty(true);
+// Replaced tables may still be read by other threads, they are only freed in cleanup().
+static Vector<TypeTable *> retired;
+
+static _FORCE_INLINE_ const TypeRange *_find(const TypeTable *p_table, size_t p_tag) {
+	uint32_t pos = hash_one_uint64(p_tag) & p_table->mask;
+	while (true) {
+		const TypeRange *range = &p_table->slots[pos];
+		if (range->tag == p_tag) {
+			return range;
+		}
+		if (range->tag == 0) {
+			return nullptr;
+		}
+		pos = (pos + 1) & p_table->mask;
+	}
+}
+
+static TypeTable *_build() {
+	// Every tag gets a node, including bases that were never registered themselves.
+	HashMap<size_t, uint32_t> node_of;
+	Vector<size_t> tags;
+	Vector<int> parents;
+
+	for (const HashMap<size_t, size_t>::Element *E = parent_to.front(); E; E = E->next) {
+		const size_t pair[2] = { E->key(), E->value() };
+		for (int i = 0; i < 2; i++) {
+			if (pair[i] != 0 && !node_of.has(pair[i])) {
+				node_of.insert(pair[i], tags.size());
+				tags.push_back(pair[i]);
+			}
+		}
+	}
+
+	const int count = tags.size();
+	parents.resize(count);
+	for (int i = 0; i < count; i++) {
+		const size_t *parent = parent_to.getptr(tags[i]);
+		parents.ptrw()[i] = (parent && *parent != 0) ? (int)node_of[*parent] : -1;
+	}
+
+	// Children lists, stored contiguously per parent.
+	Vector<int> child_start;
+	Vector<int> children;
+	child_start.resize(count + 1);
+	children.resize(count);
+	int *start = child_start.ptrw();
+	for (int i = 0; i <= count; i++) {
+		start[i] = 0;
+	}
+	for (int i = 0; i < count; i++) {
+		if (parents[i] >= 0) {
+			start[parents[i] + 1]++;
+		}
+	}
+	for (int i = 0; i < count; i++) {
+		start[i + 1] += start[i];
+	}
+	{
+		Vector<int> fill = child_start;
+		for (int i = 0; i < count; i++) {
+			if (parents[i] >= 0) {
+				children.ptrw()[fill.ptrw()[parents[i]]++] = i;
+			}
+		}
+	}
+
+	// Number the nodes in preorder, without recursion.
+	Vector<uint32_t> first;
+	Vector<uint32_t> last;
+	Vector<int> stack;
+	Vector<int> next_child;
+	first.resize(count);
+	last.resize(count);
+	next_child.resize(count);
+	for (int i = 0; i < count; i++) {
+		first.ptrw()[i] = UINT32_MAX;
+		next_child.ptrw()[i] = child_start[i];
+	}
+
+	uint32_t number = 0;
+	for (int root = 0; root < count; root++) {
+		if (parents[root] >= 0) {
+			continue;
+		}
+
+		first.ptrw()[root] = number++;
+		stack.push_back(root);
+		while (stack.size()) {
+			const int node = stack[stack.size() - 1];
+			if (next_child[node] < child_start[node + 1]) {
+				const int child = children[next_child.ptrw()[node]++];
+				first.ptrw()[child] = number++;
+				stack.push_back(child);
+			} else {
+				last.ptrw()[node] = number - 1;
+				stack.resize(stack.size() - 1);
+			}
+		}
+	}
+
+	// Only a broken hierarchy with a cycle leaves nodes unreached, they only match themselves.
+	for (int i = 0; i < count; i++) {
+		if (first[i] == UINT32_MAX) {
+			first.ptrw()[i] = number;
+			last.ptrw()[i] = number;
+			number++;
+		}
+	}
+
+	uint32_t capacity = 16;
+	while (capacity < (uint32_t)count * 2) {
+		capacity <<= 1;
+	}
+
+	TypeTable *new_table = memnew_core(TypeTable);
+	new_table->mask = capacity - 1;
+	new_table->slots = (TypeRange *)memalloc(sizeof(TypeRange) * capacity);
+	memset(new_table->slots, 0, sizeof(TypeRange) * capacity);
+
+	for (int i = 0; i < count; i++) {
+		uint32_t pos = hash_one_uint64(tags[i]) & new_table->mask;
+		while (new_table->slots[pos].tag != 0) {
+			pos = (pos + 1) & new_table->mask;
+		}
+		new_table->slots[pos].tag = tags[i];
+		new_table->slots[pos].first = first[i];
+		new_table->slots[pos].last = last[i];
+	}
+
+	return new_table;
+}
+
+static _FORCE_INLINE_ const TypeTable *_get_table() {
+	const TypeTable *current = table.load(std::memory_order_acquire);
+	if (likely(current && !dirty.load(std::memory_order_acquire))) {
+		return current;
+	}
+
+	lock.lock();
+	if (dirty.load(std::memory_order_relaxed) || !table.load(std::memory_order_relaxed)) {
+		TypeTable *old_table = table.load(std::memory_order_relaxed);
+		if (old_table) {
+			retired.push_back(old_table);
+		}
+		table.store(_build(), std::memory_order_release);
+		dirty.store(false, std::memory_order_release);
+	}
+	current = table.load(std::memory_order_relaxed);
+	lock.unlock();
+
+	return current;
+}
+
 void register_type(size_t type_tag, size_t base_type_tag) {
 	if (type_tag == base_type_tag) {
 		return;
 	}
+
+	lock.lock();
 	parent_to[type_tag] = base_type_tag;
+	dirty.store(true, std::memory_order_release);
+	lock.unlock();
 }
 
 bool is_type_known(size_t type_tag) {
-	return parent_to.find(type_tag) != NULL;
+	return _find(_get_table(), type_tag) != nullptr;
 }
 
 void register_global_type(const char *name, size_t type_tag, size_t base_type_tag) {
@@ -59,16 +238,43 @@ bool is_type_compatible(size_t ask_tag, size_t have_tag) {
 	if (have_tag == 0)
 		return false;
 
-	size_t tag = have_tag;
+	if (have_tag == ask_tag)
+		return true;
+
+	const TypeTable *types = _get_table();
+
+	const TypeRange *have = _find(types, have_tag);
+	if (!have)
+		return false;
+
+	const TypeRange *ask = _find(types, ask_tag);
+	if (!ask)
+		return false;
+
+	return have->first >= ask->first && have->first <= ask->last;
+}
+
+static void _free_table(TypeTable *p_table) {
+	memfree(p_table->slots);
+	memdelete(p_table);
+}
 
-	while (tag != 0) {
-		if (tag == ask_tag)
-			return true;
+void cleanup() {
+	lock.lock();
 
-		tag = parent_to[tag];
+	TypeTable *current = table.exchange(nullptr, std::memory_order_acq_rel);
+	if (current) {
+		_free_table(current);
+	}
+	for (int i = 0; i < retired.size(); i++) {
+		_free_table(retired[i]);
 	}
+	retired.clear();
+
+	parent_to.clear();
+	dirty.store(true, std::memory_order_release);
 
-	return false;
+	lock.unlock();
 }
 
 } // namespace _TagDB
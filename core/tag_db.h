@@ -35,11 +35,18 @@
 
 namespace _TagDB {
 
+// Registration goes into a hierarchy map. Queries run on a dense table built
+// from it on first use after a registration, where each type has the range of
+// preorder numbers of its subtree. A type derives from another when its
+// number falls in the other's range, so a check is two probes and two compares.
 void register_type(size_t type_tag, size_t base_type_tag);
 bool is_type_known(size_t type_tag);
 void register_global_type(const char *name, size_t type_tag, size_t base_type_tag);
 bool is_type_compatible(size_t type_tag, size_t base_type_tag);
 
+// Releases the tables, called when the library is terminated.
+void cleanup();
+
 } // namespace _TagDB
 
 #endif // TAGDB_H
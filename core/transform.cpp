@@ -233,6 +233,72 @@ Transform Transform::interpolate_with(const Transform &p_transform, real_t p_c)
 	return dst;
 }
 
+void Transform::compose_n(const Vector3::SoA &p_translation, const Quaternion::SoA &p_rotation, const Vector3::SoA &p_scale, Transform *r_dst, int p_count) {
+	for (int i = 0; i < p_count; ++i) {
+		// Same as Basis(Quaternion) for a normalized quaternion, followed by scaling the columns (R * S).
+		real_t qx = p_rotation.x[i], qy = p_rotation.y[i], qz = p_rotation.z[i], qw = p_rotation.w[i];
+		real_t xs = qx * 2, ys = qy * 2, zs = qz * 2;
+		real_t wx = qw * xs, wy = qw * ys, wz = qw * zs;
+		real_t xx = qx * xs, xy = qx * ys, xz = qx * zs;
+		real_t yy = qy * ys, yz = qy * zs, zz = qz * zs;
+		real_t sx = p_scale.x[i], sy = p_scale.y[i], sz = p_scale.z[i];
+
+		Transform &t = r_dst[i];
+		t.basis.elements[0].x = (1 - (yy + zz)) * sx;
+		t.basis.elements[0].y = (xy - wz) * sy;
+		t.basis.elements[0].z = (xz + wy) * sz;
+		t.basis.elements[1].x = (xy + wz) * sx;
+		t.basis.elements[1].y = (1 - (xx + zz)) * sy;
+		t.basis.elements[1].z = (yz - wx) * sz;
+		t.basis.elements[2].x = (xz - wy) * sx;
+		t.basis.elements[2].y = (yz + wx) * sy;
+		t.basis.elements[2].z = (1 - (xx + yy)) * sz;
+
+		t.origin.x = p_translation.x[i];
+		t.origin.y = p_translation.y[i];
+		t.origin.z = p_translation.z[i];
+	}
+}
+
+void Transform::decompose_n(const Transform *p_src, const Vector3::SoA &r_translation, const Quaternion::SoA &r_rotation, const Vector3::SoA &r_scale, int p_count) {
+	for (int i = 0; i < p_count; ++i) {
+		const Transform &t = p_src[i];
+
+		r_translation.x[i] = t.origin.x;
+		r_translation.y[i] = t.origin.y;
+		r_translation.z[i] = t.origin.z;
+
+		Basis rot = t.basis;
+		real_t det_sign = rot.determinant() > 0 ? 1 : -1;
+		Vector3 scale = det_sign * Vector3(rot.get_axis(0).length(), rot.get_axis(1).length(), rot.get_axis(2).length());
+
+		r_scale.x[i] = scale.x;
+		r_scale.y[i] = scale.y;
+		r_scale.z[i] = scale.z;
+
+		if (scale.x == 0 || scale.y == 0 || scale.z == 0) {
+			// Degenerate basis, there is no meaningful rotation to extract.
+			r_rotation.x[i] = 0;
+			r_rotation.y[i] = 0;
+			r_rotation.z[i] = 0;
+			r_rotation.w[i] = 1;
+			continue;
+		}
+
+		for (int r = 0; r < 3; ++r) {
+			rot.elements[r].x /= scale.x;
+			rot.elements[r].y /= scale.y;
+			rot.elements[r].z /= scale.z;
+		}
+
+		Quaternion q = rot;
+		r_rotation.x[i] = q.x;
+		r_rotation.y[i] = q.y;
+		r_rotation.z[i] = q.z;
+		r_rotation.w[i] = q.w;
+	}
+}
+
 void Transform::scale(const Vector3 &p_scale) {
 	basis.scale(p_scale);
 	origin *= p_scale;
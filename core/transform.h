@@ -35,6 +35,7 @@
 
 #include "aabb.h"
 #include "plane.h"
+#include "quaternion.h"
 
 class Transform {
 public:
@@ -100,6 +101,12 @@ public:
 
 	Transform interpolate_with(const Transform &p_transform, real_t p_c) const;
 
+	// Batched translation, rotation and scale (TRS) conversions for p_count transforms, with
+	// the tracks in structure of arrays layout. The rotations given to compose_n() must be normalized.
+	// decompose_n() follows Basis::get_scale() and folds a negative determinant into the scale.
+	static void compose_n(const Vector3::SoA &p_translation, const Quaternion::SoA &p_rotation, const Vector3::SoA &p_scale, Transform *r_dst, int p_count);
+	static void decompose_n(const Transform *p_src, const Vector3::SoA &r_translation, const Quaternion::SoA &r_rotation, const Vector3::SoA &r_scale, int p_count);
+
 	Transform inverse_xform(const Transform &t) const;
 
 	void set(real_t xx, real_t xy, real_t xz, real_t yx, real_t yy, real_t yz, real_t zx, real_t zy, real_t zz, real_t tx, real_t ty, real_t tz);
@@ -0,0 +1,203 @@
+/*************************************************************************/
+/*  typed_array.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TYPED_ARRAY_H
+#define TYPED_ARRAY_H
+
+#include "defs.h"
+
+#include "array.h"
+#include "color.h"
+#include "pool_arrays.h"
+#include "ustring.h"
+#include "variant.h"
+#include "vector2.h"
+#include "vector2i.h"
+#include "vector3.h"
+
+#include "core/containers/vector.h"
+
+#include <type_traits>
+
+// Pool array that stores T without boxing it in a Variant, if there is one.
+template <class T>
+struct PoolArrayOf {
+	enum {
+		HAS_POOL = 0,
+	};
+};
+
+#define MAKE_POOL_ARRAY_OF(m_type, m_pool) \
+	template <>                            \
+	struct PoolArrayOf<m_type> {           \
+		enum {                             \
+			HAS_POOL = 1,                  \
+		};                                 \
+		typedef m_pool Type;               \
+	};
+
+MAKE_POOL_ARRAY_OF(uint8_t, PoolByteArray)
+MAKE_POOL_ARRAY_OF(int, PoolIntArray)
+MAKE_POOL_ARRAY_OF(real_t, PoolRealArray)
+MAKE_POOL_ARRAY_OF(String, PoolStringArray)
+MAKE_POOL_ARRAY_OF(Vector2, PoolVector2Array)
+MAKE_POOL_ARRAY_OF(Vector2i, PoolVector2iArray)
+MAKE_POOL_ARRAY_OF(Vector3, PoolVector3Array)
+MAKE_POOL_ARRAY_OF(Color, PoolColorArray)
+
+#undef MAKE_POOL_ARRAY_OF
+
+// Array of T kept in native memory, to be filled and read without going
+// through the API for every element. Conversions to and from Array and the
+// Pool*Array types happen in one pass over a pre-sized destination.
+// When T has a matching pool array, conversions to and from Array go through
+// it, so the engine builds the Variants on its side in a single call.
+template <class T>
+class TypedArray {
+	typedef std::integral_constant<bool, PoolArrayOf<T>::HAS_POOL> _HasPool;
+
+	Vector<T> _data;
+
+	template <class P>
+	void _from_pool(const P &p_pool) {
+		const int size = p_pool.size();
+		_data.resize(size);
+		if (size == 0) {
+			return;
+		}
+
+		typename P::Read r = p_pool.read();
+		const auto *src = r.ptr();
+		T *dst = _data.ptrw();
+		for (int i = 0; i < size; i++) {
+			dst[i] = src[i];
+		}
+	}
+
+	void _from_array(const Array &p_array, std::true_type) {
+		_from_pool(typename PoolArrayOf<T>::Type(p_array));
+	}
+
+	void _from_array(const Array &p_array, std::false_type) {
+		const int size = p_array.size();
+		_data.resize(size);
+		if (size == 0) {
+			return;
+		}
+
+		// Array elements are contiguous, only the first one is looked up.
+		const Variant *src = &p_array[0];
+		T *dst = _data.ptrw();
+		for (int i = 0; i < size; i++) {
+			dst[i] = src[i];
+		}
+	}
+
+	Array _to_array(std::true_type) const {
+		return Array(to_pool());
+	}
+
+	Array _to_array(std::false_type) const {
+		Array array;
+		const int size = _data.size();
+		array.resize(size);
+		if (size == 0) {
+			return array;
+		}
+
+		Variant *dst = &array[0];
+		const T *src = _data.ptr();
+		for (int i = 0; i < size; i++) {
+			dst[i] = Variant(src[i]);
+		}
+
+		return array;
+	}
+
+public:
+	_FORCE_INLINE_ int size() const { return _data.size(); }
+	_FORCE_INLINE_ bool empty() const { return _data.empty(); }
+	_FORCE_INLINE_ void clear() { _data.clear(); }
+	_FORCE_INLINE_ void resize(int p_size) { _data.resize(p_size); }
+	_FORCE_INLINE_ void push_back(const T &p_elem) { _data.push_back(p_elem); }
+
+	_FORCE_INLINE_ const T *ptr() const { return _data.ptr(); }
+	_FORCE_INLINE_ T *ptrw() { return _data.ptrw(); }
+
+	_FORCE_INLINE_ const Vector<T> &get_data() const { return _data; }
+	_FORCE_INLINE_ Vector<T> &get_data() { return _data; }
+
+	_FORCE_INLINE_ const T &operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, _data.size());
+		return _data.ptr()[p_index];
+	}
+	_FORCE_INLINE_ T &operator[](int p_index) {
+		CRASH_BAD_INDEX(p_index, _data.size());
+		return _data.ptrw()[p_index];
+	}
+
+	Array to_array() const {
+		return _to_array(_HasPool());
+	}
+
+	_FORCE_INLINE_ operator Array() const { return to_array(); }
+
+	template <class U = T>
+	typename PoolArrayOf<U>::Type to_pool() const {
+		typename PoolArrayOf<U>::Type pool;
+		const int size = _data.size();
+		pool.resize(size);
+		if (size == 0) {
+			return pool;
+		}
+
+		typename PoolArrayOf<U>::Type::Write w = pool.write();
+		auto *dst = w.ptr();
+		const T *src = _data.ptr();
+		for (int i = 0; i < size; i++) {
+			dst[i] = src[i];
+		}
+
+		return pool;
+	}
+
+	TypedArray() {}
+	TypedArray(const Vector<T> &p_data) :
+			_data(p_data) {}
+	TypedArray(const Array &p_array) {
+		_from_array(p_array, _HasPool());
+	}
+	template <class U = T>
+	TypedArray(const typename PoolArrayOf<U>::Type &p_pool) {
+		_from_pool(p_pool);
+	}
+};
+
+#endif // TYPED_ARRAY_H
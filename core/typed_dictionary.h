@@ -0,0 +1,91 @@
+/*************************************************************************/
+/*  typed_dictionary.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TYPED_DICTIONARY_H
+#define TYPED_DICTIONARY_H
+
+#include "defs.h"
+
+#include "dictionary.h"
+#include "variant.h"
+
+#include "core/containers/hash_map.h"
+
+// Dictionary with native keys and values, kept in insertion order like
+// Dictionary itself. The API has no bulk insertion, so to_dictionary() still
+// sets one entry per call, but nothing in between touches the engine.
+template <class K, class V>
+class TypedDictionary {
+	HashMap<K, V> _data;
+
+public:
+	typedef typename HashMap<K, V>::Element Element;
+
+	_FORCE_INLINE_ int size() const { return _data.size(); }
+	_FORCE_INLINE_ bool empty() const { return _data.empty(); }
+	_FORCE_INLINE_ void clear() { _data.clear(); }
+	_FORCE_INLINE_ void reserve(int p_capacity) { _data.reserve(p_capacity); }
+
+	_FORCE_INLINE_ bool has(const K &p_key) const { return _data.has(p_key); }
+	_FORCE_INLINE_ bool erase(const K &p_key) { return _data.erase(p_key); }
+	_FORCE_INLINE_ const V *getptr(const K &p_key) const { return _data.getptr(p_key); }
+	_FORCE_INLINE_ V *getptr(const K &p_key) { return _data.getptr(p_key); }
+	_FORCE_INLINE_ void set(const K &p_key, const V &p_value) { _data.insert(p_key, p_value); }
+
+	_FORCE_INLINE_ const V &operator[](const K &p_key) const { return _data[p_key]; }
+	_FORCE_INLINE_ V &operator[](const K &p_key) { return _data[p_key]; }
+
+	// for (const TypedDictionary<K, V>::Element *E = dict.front(); E; E = E->next)
+	_FORCE_INLINE_ const Element *front() const { return _data.front(); }
+	_FORCE_INLINE_ Element *front() { return _data.front(); }
+
+	_FORCE_INLINE_ const HashMap<K, V> &get_data() const { return _data; }
+	_FORCE_INLINE_ HashMap<K, V> &get_data() { return _data; }
+
+	Dictionary to_dictionary() const {
+		Dictionary dictionary;
+		for (const Element *E = _data.front(); E; E = E->next) {
+			dictionary[Variant(E->key())] = Variant(E->value());
+		}
+		return dictionary;
+	}
+
+	_FORCE_INLINE_ operator Dictionary() const { return to_dictionary(); }
+
+	TypedDictionary() {}
+	TypedDictionary(const Dictionary &p_dictionary) {
+		_data.reserve(p_dictionary.size());
+		for (const Dictionary::Element &E : p_dictionary) {
+			_data.insert(E.key(), E.value());
+		}
+	}
+};
+
+#endif // TYPED_DICTIONARY_H
@@ -34,11 +34,15 @@
 #include "node_path.h"
 #include "pandemonium_global.h"
 #include "pool_arrays.h"
+#include "string_view.h"
 #include "variant.h"
 
 #include <gdn/string.h>
 
+#include <locale.h>
+#include <stdio.h>
 #include <string.h>
+#include <cmath>
 
 CharString::~CharString() {
 	Pandemonium::api->pandemonium_char_string_destroy(&_char_string);
@@ -80,6 +84,95 @@ String String::num_int64(int64_t p_num, int base, bool capitalize_hex) {
 	return String(Pandemonium::api->pandemonium_string_num_int64_capitalized(p_num, base, capitalize_hex));
 }
 
+int String::num_to_buffer(double p_num, char32_t *r_buffer, int p_decimals) {
+	char buffer[NUM_MAX_CHARS];
+	int len;
+
+	if (std::isnan(p_num)) {
+		len = snprintf(buffer, sizeof(buffer), "nan");
+	} else if (std::isinf(p_num)) {
+		len = snprintf(buffer, sizeof(buffer), p_num < 0 ? "-inf" : "inf");
+	} else {
+		// Same digit selection as the engine's String::num().
+		if (p_decimals < 0) {
+			p_decimals = 14;
+			const double abs_num = ABS(p_num);
+			if (abs_num > 10) {
+				p_decimals -= (int)std::floor(std::log10(abs_num));
+			}
+		}
+		p_decimals = CLAMP(p_decimals, 0, 32);
+
+		len = snprintf(buffer, sizeof(buffer), "%.*f", p_decimals, p_num);
+		len = MIN(len, (int)sizeof(buffer) - 1);
+
+		// snprintf writes the decimal separator of the current locale.
+		const char *point = localeconv()->decimal_point;
+		if (point[0] != '.' || point[1] != 0) {
+			char *at = strstr(buffer, point);
+			if (at) {
+				const int point_length = strlen(point);
+				*at = '.';
+				memmove(at + 1, at + point_length, buffer + len + 1 - (at + point_length));
+				len -= point_length - 1;
+			}
+		}
+
+		if (p_decimals > 0) {
+			while (buffer[len - 1] == '0') {
+				len--;
+			}
+			if (buffer[len - 1] == '.') {
+				len--;
+			}
+		}
+	}
+
+	for (int i = 0; i < len; i++) {
+		r_buffer[i] = (char32_t)buffer[i];
+	}
+
+	return len;
+}
+
+int String::num_int64_to_buffer(int64_t p_num, char32_t *r_buffer, int base, bool capitalize_hex) {
+	ERR_FAIL_COND_V(base < 2 || base > 36, 0);
+
+	char32_t digits[NUM_INT64_MAX_CHARS];
+	int count = 0;
+
+	const bool sign = p_num < 0;
+	uint64_t n = sign ? (uint64_t)0 - (uint64_t)p_num : (uint64_t)p_num;
+	const char32_t alpha = capitalize_hex ? 'A' : 'a';
+
+	do {
+		const uint32_t digit = (uint32_t)(n % base);
+		digits[count++] = digit < 10 ? '0' + digit : alpha + (digit - 10);
+		n /= base;
+	} while (n);
+
+	int len = 0;
+	if (sign) {
+		r_buffer[len++] = '-';
+	}
+	while (count) {
+		r_buffer[len++] = digits[--count];
+	}
+
+	return len;
+}
+
+int String::hex_encode_to_buffer(const uint8_t *p_buffer, int p_len, char32_t *r_buffer) {
+	static const char hex[] = "0123456789abcdef";
+
+	for (int i = 0; i < p_len; i++) {
+		r_buffer[i * 2 + 0] = hex[p_buffer[i] >> 4];
+		r_buffer[i * 2 + 1] = hex[p_buffer[i] & 0xF];
+	}
+
+	return p_len * 2;
+}
+
 String String::chr(pandemonium_char_type p_char) {
 	return String(Pandemonium::api->pandemonium_string_chr(p_char));
 }
@@ -190,18 +283,18 @@ const char32_t *String::unicode_str() const {
 }
 
 char *String::alloc_c_string() const {
-	pandemonium_char_string contents = Pandemonium::api->pandemonium_string_utf8(&_pandemonium_string);
-
-	int length = Pandemonium::api->pandemonium_char_string_length(&contents);
+	// Encodes straight into the returned buffer, without a CharString in between.
+	StringView view(*this);
+	int length = Utf8Encoder::encoded_length(view.ptr(), view.length());
 
 	char *result = (char *)Pandemonium::api->pandemonium_alloc(length + 1);
 
 	if (result) {
-		memcpy(result, Pandemonium::api->pandemonium_char_string_get_data(&contents), length + 1);
+		int consumed;
+		Utf8Encoder::encode(view.ptr(), view.length(), result, length, consumed);
+		result[length] = 0;
 	}
 
-	Pandemonium::api->pandemonium_char_string_destroy(&contents);
-
 	return result;
 }
 
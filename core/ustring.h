@@ -73,6 +73,7 @@ class String {
 	friend class NodePath;
 	friend class Variant;
 	friend class StringName;
+	friend class StringView;
 
 	explicit inline String(pandemonium_string contents) :
 			_pandemonium_string(contents) {}
@@ -95,6 +96,19 @@ public:
 	static String md5(const uint8_t *p_md5);
 	static String hex_encode_buffer(const uint8_t *p_buffer, int p_len);
 
+	enum {
+		NUM_MAX_CHARS = 352,
+		NUM_INT64_MAX_CHARS = 66,
+	};
+
+	// Non-allocating variants of num(), num_int64() and hex_encode_buffer().
+	// They write into r_buffer, which needs room for NUM_MAX_CHARS,
+	// NUM_INT64_MAX_CHARS or p_len * 2 characters, and return the length
+	// written. Nothing is null terminated.
+	static int num_to_buffer(double p_num, char32_t *r_buffer, int p_decimals = -1);
+	static int num_int64_to_buffer(int64_t p_num, char32_t *r_buffer, int base = 10, bool capitalize_hex = false);
+	static int hex_encode_to_buffer(const uint8_t *p_buffer, int p_len, char32_t *r_buffer);
+
 	char32_t &operator[](const int idx);
 	char32_t operator[](const int idx) const;
 
@@ -205,6 +205,10 @@ Variant::Variant(const PoolVector2Array &p_vector2_array) {
 	Pandemonium::api->pandemonium_variant_new_pool_vector2_array(&_pandemonium_variant, (pandemonium_pool_vector2_array *)&p_vector2_array);
 }
 
+Variant::Variant(const PoolVector2iArray &p_vector2i_array) {
+	Pandemonium::api->pandemonium_variant_new_pool_vector2i_array(&_pandemonium_variant, (pandemonium_pool_vector2i_array *)&p_vector2i_array);
+}
+
 Variant::Variant(const PoolVector3Array &p_vector3_array) {
 	Pandemonium::api->pandemonium_variant_new_pool_vector3_array(&_pandemonium_variant, (pandemonium_pool_vector3_array *)&p_vector3_array);
 }
@@ -371,6 +375,10 @@ Variant::operator PoolVector2Array() const {
 	pandemonium_pool_vector2_array ret = Pandemonium::api->pandemonium_variant_as_pool_vector2_array(&_pandemonium_variant);
 	return PoolVector2Array(ret);
 }
+Variant::operator PoolVector2iArray() const {
+	pandemonium_pool_vector2i_array ret = Pandemonium::api->pandemonium_variant_as_pool_vector2i_array(&_pandemonium_variant);
+	return PoolVector2iArray(ret);
+}
 Variant::operator PoolVector3Array() const {
 	pandemonium_pool_vector3_array ret = Pandemonium::api->pandemonium_variant_as_pool_vector3_array(&_pandemonium_variant);
 	return PoolVector3Array(ret);
@@ -245,6 +245,8 @@ public:
 
 	Variant(const PoolVector2Array &p_vector2_array);
 
+	Variant(const PoolVector2iArray &p_vector2i_array);
+
 	Variant(const PoolVector3Array &p_vector3_array);
 
 	Variant(const PoolColorArray &p_color_array);
@@ -301,6 +303,7 @@ public:
 	operator PoolRealArray() const;
 	operator PoolStringArray() const;
 	operator PoolVector2Array() const;
+	operator PoolVector2iArray() const;
 	operator PoolVector3Array() const;
 	operator PoolColorArray() const;
 
@@ -0,0 +1,600 @@
+/*************************************************************************/
+/*  variant_serializer.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "variant_serializer.h"
+
+#include "aabb.h"
+#include "array.h"
+#include "basis.h"
+#include "color.h"
+#include "dictionary.h"
+#include "node_path.h"
+#include "os/memory.h"
+#include "plane.h"
+#include "projection.h"
+#include "quaternion.h"
+#include "rect2.h"
+#include "rect2i.h"
+#include "string_name.h"
+#include "transform.h"
+#include "transform_2d.h"
+#include "vector2.h"
+#include "vector2i.h"
+#include "vector3.h"
+#include "vector3i.h"
+#include "vector4.h"
+#include "vector4i.h"
+
+static const uint8_t _magic[4] = { 'P', 'V', 'A', 'R' };
+
+// Tag bits above the type.
+#define TAG_TYPE_MASK 0x3F
+#define TAG_FLAG 0x40
+
+/* VariantEncoder */
+
+void VariantEncoder::_grow(int p_min_capacity) {
+	int capacity = MAX(_capacity, 64);
+	while (capacity < p_min_capacity) {
+		capacity <<= 1;
+	}
+
+	uint8_t *data = (uint8_t *)memrealloc(_data, capacity);
+	CRASH_COND_MSG(!data, "Out of memory while serializing a Variant.");
+
+	_data = data;
+	_capacity = capacity;
+}
+
+void VariantEncoder::_write_varint(uint64_t p_value) {
+	uint8_t *dst = _tail(10);
+	int count = 0;
+	while (p_value >= 0x80) {
+		dst[count++] = (uint8_t)(p_value | 0x80);
+		p_value >>= 7;
+	}
+	dst[count++] = (uint8_t)p_value;
+	_size += count;
+}
+
+void VariantEncoder::_write_bytes(const void *p_data, int p_size) {
+	memcpy(_tail(p_size), p_data, p_size);
+	_size += p_size;
+}
+
+void VariantEncoder::_write_string(const String &p_string) {
+	const StringView view(p_string);
+	const bool shared = (_flags & FLAG_STRING_TABLE) && view.length() <= MAX_SHARED_LENGTH;
+
+	if (shared) {
+		const uint32_t *index = _strings.getptr(p_string);
+		if (index) {
+			_write_varint(((uint64_t)*index << 1) | 1);
+			return;
+		}
+	}
+
+	const int length = Utf8Encoder::encoded_length(view.ptr(), view.length());
+	_write_varint((uint64_t)length << 1);
+
+	int consumed = 0;
+	Utf8Encoder::encode(view.ptr(), view.length(), (char *)_tail(length), length, consumed);
+	_size += length;
+
+	// The decoder numbers strings by their encoded length, so this has to use the same test.
+	if (shared && length <= MAX_SHARED_LENGTH) {
+		_strings.insert(p_string, _string_count++);
+	}
+}
+
+template <class P, class T>
+void VariantEncoder::_write_pool(const P &p_pool) {
+	const int count = p_pool.size();
+	_write_varint(count);
+	if (count == 0) {
+		return;
+	}
+
+	typename P::Read r = p_pool.read();
+	_write_bytes(r.ptr(), count * sizeof(T));
+}
+
+Error VariantEncoder::_encode(const Variant &p_value, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > MAX_DEPTH, ERR_INVALID_DATA, "Variant is nested too deeply to be serialized, it may contain itself.");
+
+	const Variant::Type type = p_value.get_type();
+
+#define ENCODE_RAW(m_type, m_class)   \
+	case Variant::m_type: {           \
+		_write_byte(Variant::m_type); \
+		_write_raw<m_class>(p_value); \
+	} break;
+
+	switch (type) {
+		case Variant::NIL:
+		case Variant::OBJECT:
+		case Variant::RID: {
+			_write_byte(type);
+		} break;
+		case Variant::BOOL: {
+			_write_byte(Variant::BOOL | ((bool)p_value ? TAG_FLAG : 0));
+		} break;
+		case Variant::INT: {
+			const int64_t value = p_value;
+			_write_byte(Variant::INT);
+			_write_varint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+		} break;
+		case Variant::REAL: {
+			const double value = p_value;
+			const float narrow = (float)value;
+			if ((double)narrow == value) {
+				_write_byte(Variant::REAL | TAG_FLAG);
+				_write_raw(narrow);
+			} else {
+				_write_byte(Variant::REAL);
+				_write_raw(value);
+			}
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+		case Variant::NODE_PATH: {
+			_write_byte(type);
+			_write_string(p_value);
+		} break;
+
+			ENCODE_RAW(VECTOR2, Vector2)
+			ENCODE_RAW(VECTOR2I, Vector2i)
+			ENCODE_RAW(RECT2, Rect2)
+			ENCODE_RAW(RECT2I, Rect2i)
+			ENCODE_RAW(VECTOR3, Vector3)
+			ENCODE_RAW(VECTOR3I, Vector3i)
+			ENCODE_RAW(VECTOR4, Vector4)
+			ENCODE_RAW(VECTOR4I, Vector4i)
+			ENCODE_RAW(PLANE, Plane)
+			ENCODE_RAW(QUATERNION, Quaternion)
+			ENCODE_RAW(AABB, ::AABB)
+			ENCODE_RAW(BASIS, Basis)
+			ENCODE_RAW(TRANSFORM, Transform)
+			ENCODE_RAW(TRANSFORM2D, Transform2D)
+			ENCODE_RAW(PROJECTION, Projection)
+			ENCODE_RAW(COLOR, Color)
+
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			_write_byte(Variant::DICTIONARY);
+			_write_varint(dictionary.size());
+
+			for (const Dictionary::Element &E : dictionary) {
+				Error err = _encode(E.key(), p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+				err = _encode(E.value(), p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::POOL_BYTE_ARRAY: {
+			_write_byte(type);
+			_write_pool<PoolByteArray, uint8_t>(p_value);
+		} break;
+		case Variant::POOL_INT_ARRAY: {
+			_write_byte(type);
+			_write_pool<PoolIntArray, int>(p_value);
+		} break;
+		case Variant::POOL_REAL_ARRAY: {
+			_write_byte(type);
+			_write_pool<PoolRealArray, real_t>(p_value);
+		} break;
+		case Variant::POOL_STRING_ARRAY: {
+			const PoolStringArray pool = p_value;
+			const int count = pool.size();
+			_write_byte(type);
+			_write_varint(count);
+
+			if (count > 0) {
+				PoolStringArray::Read r = pool.read();
+				const String *src = r.ptr();
+				for (int i = 0; i < count; i++) {
+					_write_string(src[i]);
+				}
+			}
+		} break;
+		case Variant::POOL_VECTOR2_ARRAY: {
+			_write_byte(type);
+			_write_pool<PoolVector2Array, Vector2>(p_value);
+		} break;
+		case Variant::POOL_VECTOR2I_ARRAY: {
+			_write_byte(type);
+			_write_pool<PoolVector2iArray, Vector2i>(p_value);
+		} break;
+		case Variant::POOL_VECTOR3_ARRAY: {
+			_write_byte(type);
+			_write_pool<PoolVector3Array, Vector3>(p_value);
+		} break;
+		case Variant::POOL_COLOR_ARRAY: {
+			_write_byte(type);
+			_write_pool<PoolColorArray, Color>(p_value);
+		} break;
+		default: {
+			// ARRAY, and the pool arrays without a native wrapper, converted by the engine.
+			const Array array = p_value;
+			const int count = array.size();
+			_write_byte(Variant::ARRAY);
+			_write_varint(count);
+
+			if (count > 0) {
+				const Variant *src = &array[0];
+				for (int i = 0; i < count; i++) {
+					const Error err = _encode(src[i], p_depth + 1);
+					if (err != OK) {
+						return err;
+					}
+				}
+			}
+		} break;
+	}
+
+#undef ENCODE_RAW
+
+	return OK;
+}
+
+Error VariantEncoder::encode(const Variant &p_value, int p_flags) {
+	_size = 0;
+	_flags = (p_flags & ~LAYOUT_FLAGS) | get_host_layout();
+	_strings.clear();
+	_string_count = 0;
+
+	_write_bytes(_magic, sizeof(_magic));
+	_write_byte(FORMAT_VERSION);
+	_write_byte(_flags);
+
+	const Error err = _encode(p_value, 0);
+
+	// The strings are only needed while encoding, don't keep them alive.
+	_strings.clear();
+
+	if (err != OK) {
+		_size = 0;
+	}
+	return err;
+}
+
+PoolByteArray VariantEncoder::to_pool_byte_array() const {
+	PoolByteArray pool;
+	pool.resize(_size);
+
+	if (_size > 0) {
+		PoolByteArray::Write w = pool.write();
+		memcpy(w.ptr(), _data, _size);
+	}
+
+	return pool;
+}
+
+VariantEncoder::VariantEncoder() :
+		_data(nullptr),
+		_size(0),
+		_capacity(0),
+		_flags(0),
+		_string_count(0) {
+}
+
+VariantEncoder::~VariantEncoder() {
+	if (_data) {
+		memfree(_data);
+	}
+}
+
+/* VariantDecoder */
+
+bool VariantDecoder::_read_varint(uint64_t &r_value) {
+	uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (unlikely(_src >= _end)) {
+			return false;
+		}
+
+		const uint8_t byte = *_src++;
+		value |= (uint64_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			r_value = value;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool VariantDecoder::_read_string(String &r_string) {
+	uint64_t header;
+	if (!_read_varint(header)) {
+		return false;
+	}
+
+	if (header & 1) {
+		const uint64_t index = header >> 1;
+		if (unlikely(index >= (uint64_t)_strings.size())) {
+			return false;
+		}
+		r_string = _strings[index];
+		return true;
+	}
+
+	const uint64_t length = header >> 1;
+	if (unlikely(length > (uint64_t)(_end - _src))) {
+		return false;
+	}
+
+	r_string = Utf8StringView((const char *)_src, (int)length).to_string();
+	_src += length;
+
+	if ((_flags & VariantEncoder::FLAG_STRING_TABLE) && length <= VariantEncoder::MAX_SHARED_LENGTH) {
+		_strings.push_back(r_string);
+	}
+
+	return true;
+}
+
+template <class P, class T>
+bool VariantDecoder::_read_pool(Variant &r_value) {
+	uint64_t count;
+	if (!_read_varint(count) || count > (uint64_t)(_end - _src) / sizeof(T)) {
+		return false;
+	}
+
+	P pool;
+	if (count > 0) {
+		pool.resize(count);
+		typename P::Write w = pool.write();
+		memcpy(w.ptr(), _src, count * sizeof(T));
+		_src += count * sizeof(T);
+	}
+
+	r_value = pool;
+	return true;
+}
+
+Error VariantDecoder::_decode(Variant &r_value, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > VariantEncoder::MAX_DEPTH, ERR_FILE_CORRUPT, "Serialized Variant is nested too deeply.");
+
+	if (unlikely(_src >= _end)) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	const uint8_t tag = *_src++;
+	const int type = tag & TAG_TYPE_MASK;
+
+#define DECODE_RAW(m_type, m_class)  \
+	case Variant::m_type: {          \
+		m_class value;               \
+		if (!_read_raw(value)) {     \
+			return ERR_FILE_CORRUPT; \
+		}                            \
+		r_value = value;             \
+	} break;
+
+#define DECODE_POOL(m_type, m_pool, m_class)         \
+	case Variant::m_type: {                          \
+		if (!_read_pool<m_pool, m_class>(r_value)) { \
+			return ERR_FILE_CORRUPT;                 \
+		}                                            \
+	} break;
+
+	switch (type) {
+		case Variant::NIL:
+		case Variant::OBJECT: {
+			r_value = Variant();
+		} break;
+		case Variant::RID: {
+			r_value = ::RID();
+		} break;
+		case Variant::BOOL: {
+			r_value = (tag & TAG_FLAG) != 0;
+		} break;
+		case Variant::INT: {
+			uint64_t value;
+			if (!_read_varint(value)) {
+				return ERR_FILE_CORRUPT;
+			}
+			r_value = (int64_t)((value >> 1) ^ (0 - (value & 1)));
+		} break;
+		case Variant::REAL: {
+			if (tag & TAG_FLAG) {
+				float value;
+				if (!_read_raw(value)) {
+					return ERR_FILE_CORRUPT;
+				}
+				r_value = value;
+			} else {
+				double value;
+				if (!_read_raw(value)) {
+					return ERR_FILE_CORRUPT;
+				}
+				r_value = value;
+			}
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+		case Variant::NODE_PATH: {
+			String value;
+			if (!_read_string(value)) {
+				return ERR_FILE_CORRUPT;
+			}
+
+			if (type == Variant::STRING_NAME) {
+				r_value = StringName(value);
+			} else if (type == Variant::NODE_PATH) {
+				r_value = NodePath(value);
+			} else {
+				r_value = value;
+			}
+		} break;
+
+			DECODE_RAW(VECTOR2, Vector2)
+			DECODE_RAW(VECTOR2I, Vector2i)
+			DECODE_RAW(RECT2, Rect2)
+			DECODE_RAW(RECT2I, Rect2i)
+			DECODE_RAW(VECTOR3, Vector3)
+			DECODE_RAW(VECTOR3I, Vector3i)
+			DECODE_RAW(VECTOR4, Vector4)
+			DECODE_RAW(VECTOR4I, Vector4i)
+			DECODE_RAW(PLANE, Plane)
+			DECODE_RAW(QUATERNION, Quaternion)
+			DECODE_RAW(AABB, ::AABB)
+			DECODE_RAW(BASIS, Basis)
+			DECODE_RAW(TRANSFORM, Transform)
+			DECODE_RAW(TRANSFORM2D, Transform2D)
+			DECODE_RAW(PROJECTION, Projection)
+			DECODE_RAW(COLOR, Color)
+
+		case Variant::DICTIONARY: {
+			// Every entry takes at least two bytes, larger counts can't be valid.
+			uint64_t count;
+			if (!_read_varint(count) || count > (uint64_t)(_end - _src) / 2) {
+				return ERR_FILE_CORRUPT;
+			}
+
+			Dictionary dictionary;
+			for (uint64_t i = 0; i < count; i++) {
+				Variant key;
+				Error err = _decode(key, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+				err = _decode(dictionary[key], p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+			}
+			r_value = dictionary;
+		} break;
+		case Variant::ARRAY: {
+			uint64_t count;
+			if (!_read_varint(count) || count > (uint64_t)(_end - _src)) {
+				return ERR_FILE_CORRUPT;
+			}
+
+			Array array;
+			array.resize(count);
+			if (count > 0) {
+				// Elements are decoded in place, the Array is never resized again.
+				Variant *dst = &array[0];
+				for (uint64_t i = 0; i < count; i++) {
+					const Error err = _decode(dst[i], p_depth + 1);
+					if (err != OK) {
+						return err;
+					}
+				}
+			}
+			r_value = array;
+		} break;
+
+			DECODE_POOL(POOL_BYTE_ARRAY, PoolByteArray, uint8_t)
+			DECODE_POOL(POOL_INT_ARRAY, PoolIntArray, int)
+			DECODE_POOL(POOL_REAL_ARRAY, PoolRealArray, real_t)
+			DECODE_POOL(POOL_VECTOR2_ARRAY, PoolVector2Array, Vector2)
+			DECODE_POOL(POOL_VECTOR2I_ARRAY, PoolVector2iArray, Vector2i)
+			DECODE_POOL(POOL_VECTOR3_ARRAY, PoolVector3Array, Vector3)
+			DECODE_POOL(POOL_COLOR_ARRAY, PoolColorArray, Color)
+
+		case Variant::POOL_STRING_ARRAY: {
+			uint64_t count;
+			if (!_read_varint(count) || count > (uint64_t)(_end - _src)) {
+				return ERR_FILE_CORRUPT;
+			}
+
+			PoolStringArray pool;
+			if (count > 0) {
+				pool.resize(count);
+				PoolStringArray::Write w = pool.write();
+				String *dst = w.ptr();
+				for (uint64_t i = 0; i < count; i++) {
+					if (!_read_string(dst[i])) {
+						return ERR_FILE_CORRUPT;
+					}
+				}
+			}
+			r_value = pool;
+		} break;
+		default: {
+			return ERR_FILE_CORRUPT;
+		}
+	}
+
+#undef DECODE_POOL
+#undef DECODE_RAW
+
+	return OK;
+}
+
+Error VariantDecoder::decode(const uint8_t *p_data, int p_size, Variant &r_value) {
+	ERR_FAIL_COND_V(!p_data && p_size > 0, ERR_INVALID_PARAMETER);
+
+	_begin = p_data;
+	_src = p_data;
+	_end = p_data + p_size;
+	_strings.clear();
+
+	if (p_size < (int)sizeof(_magic) + 2 || memcmp(p_data, _magic, sizeof(_magic)) != 0) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	_src += sizeof(_magic);
+
+	const uint8_t version = *_src++;
+	ERR_FAIL_COND_V_MSG(version > VariantEncoder::FORMAT_VERSION, ERR_FILE_UNRECOGNIZED, "Serialized Variant was written by a newer version.");
+
+	_flags = *_src++;
+
+	// Raw values are stored as the writing host laid them out.
+	ERR_FAIL_COND_V_MSG((_flags & VariantEncoder::LAYOUT_FLAGS) != VariantEncoder::get_host_layout(), ERR_FILE_CORRUPT, "Serialized Variant was written with a different byte order or real_t size.");
+
+	const Error err = _decode(r_value, 0);
+
+	// Release the table, the strings may be large and are not needed anymore.
+	_strings.clear();
+
+	return err;
+}
+
+Error VariantDecoder::decode(const PoolByteArray &p_data, Variant &r_value) {
+	const int size = p_data.size();
+	PoolByteArray::Read r = p_data.read();
+	return decode(r.ptr(), size, r_value);
+}
+
+VariantDecoder::VariantDecoder() :
+		_begin(nullptr),
+		_src(nullptr),
+		_end(nullptr),
+		_flags(0) {
+}
@@ -0,0 +1,196 @@
+/*************************************************************************/
+/*  variant_serializer.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           PANDEMONIUM ENGINE                                */
+/*                      https://pandemoniumengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Pandemonium Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef VARIANT_SERIALIZER_H
+#define VARIANT_SERIALIZER_H
+
+#include "defs.h"
+
+#include "pool_arrays.h"
+#include "string_view.h"
+#include "ustring.h"
+#include "variant.h"
+
+#include "core/containers/hash_map.h"
+#include "core/containers/vector.h"
+
+#include <string.h>
+#include <type_traits>
+
+// Compact binary encoding of Variants, done entirely on the native side.
+//
+// Layout:
+//   header: 'P' 'V' 'A' 'R', version byte, flags byte
+//   value:  tag byte (Variant::Type, 0x40 set for true BOOL and float32 REAL)
+//           followed by its payload:
+//   - INT: zigzag varint.
+//   - REAL: 4 or 8 bytes, whichever keeps the exact value.
+//   - STRING, STRING_NAME, NODE_PATH: varint (byte length << 1) and the UTF-8
+//     text, or varint (index << 1 | 1) referring to an earlier string. With
+//     FLAG_STRING_TABLE, every inline string of up to MAX_SHARED_LENGTH bytes
+//     gets the next index, in order of appearance.
+//   - Math types and COLOR: their memory layout, as shared with the engine.
+//     This and the raw pool elements use the byte order and real_t size of
+//     the host that wrote them, which the flags record. Data from a host that
+//     differs in either is rejected when decoding.
+//   - ARRAY, DICTIONARY: varint count, then the elements or key/value pairs.
+//   - POOL_STRING_ARRAY: varint count, then the strings.
+//   - Other pool arrays: varint count and the raw elements.
+//   - OBJECT and RID: nothing, they don't survive serialization and decode as
+//     null and an empty RID.
+// Pool arrays of Vector3i, Vector4 and Vector4i have no native wrapper, and
+// are written as ARRAY.
+class VariantEncoder {
+public:
+	enum {
+		FORMAT_VERSION = 1,
+		MAX_DEPTH = 512,
+		MAX_SHARED_LENGTH = 128,
+	};
+
+	enum Flags {
+		// Strings repeated in the data, like dictionary keys, are written once.
+		FLAG_STRING_TABLE = 1,
+		// Set by the encoder from the host, see get_host_layout().
+		FLAG_REAL_T_DOUBLE = 2,
+		FLAG_BIG_ENDIAN = 4,
+		LAYOUT_FLAGS = FLAG_REAL_T_DOUBLE | FLAG_BIG_ENDIAN,
+	};
+
+	// The layout flags matching how this build stores raw values.
+	static _FORCE_INLINE_ int get_host_layout() {
+		const uint16_t probe = 1;
+		const bool big_endian = *(const uint8_t *)&probe == 0;
+		return (sizeof(real_t) == 8 ? FLAG_REAL_T_DOUBLE : 0) | (big_endian ? FLAG_BIG_ENDIAN : 0);
+	}
+
+private:
+	// Hashes on the native copy of the text, without an engine call.
+	struct _StringHasher {
+		static _FORCE_INLINE_ uint32_t hash(const String &p_string) { return StringView(p_string).hash(); }
+	};
+
+	uint8_t *_data;
+	int _size;
+	int _capacity;
+
+	int _flags;
+	HashMap<String, uint32_t, _StringHasher> _strings;
+	uint32_t _string_count;
+
+	void _grow(int p_min_capacity);
+
+	_FORCE_INLINE_ uint8_t *_tail(int p_count) {
+		if (unlikely(_size + p_count > _capacity)) {
+			_grow(_size + p_count);
+		}
+		return _data + _size;
+	}
+
+	_FORCE_INLINE_ void _write_byte(uint8_t p_byte) {
+		*_tail(1) = p_byte;
+		_size++;
+	}
+
+	void _write_varint(uint64_t p_value);
+	void _write_bytes(const void *p_data, int p_size);
+	void _write_string(const String &p_string);
+
+	template <class T>
+	_FORCE_INLINE_ void _write_raw(const T &p_value) {
+		_write_bytes(&p_value, sizeof(T));
+	}
+
+	template <class P, class T>
+	void _write_pool(const P &p_pool);
+
+	Error _encode(const Variant &p_value, int p_depth);
+
+	VariantEncoder(const VariantEncoder &p_from);
+	VariantEncoder &operator=(const VariantEncoder &p_from);
+
+public:
+	// Replaces the current contents with p_value. The buffer is kept between
+	// calls, so an encoder can be reused for every packet or save.
+	Error encode(const Variant &p_value, int p_flags = FLAG_STRING_TABLE);
+
+	_FORCE_INLINE_ const uint8_t *get_data() const { return _data; }
+	_FORCE_INLINE_ int get_size() const { return _size; }
+
+	PoolByteArray to_pool_byte_array() const;
+
+	VariantEncoder();
+	~VariantEncoder();
+};
+
+// Reads data written by VariantEncoder straight from the caller's memory,
+// for example a mapped file or a received packet, without copying it first.
+// Every length and count is checked against the data, so untrusted input
+// fails with ERR_FILE_CORRUPT instead of reading out of bounds.
+class VariantDecoder {
+	const uint8_t *_begin;
+	const uint8_t *_src;
+	const uint8_t *_end;
+
+	int _flags;
+	Vector<String> _strings;
+
+	bool _read_varint(uint64_t &r_value);
+	bool _read_string(String &r_string);
+
+	// r_value is default constructed by the caller, only its components are
+	// filled in, the way VariantEncoder::_write_raw() wrote them.
+	template <class T>
+	_FORCE_INLINE_ bool _read_raw(T &r_value) {
+		static_assert(std::is_standard_layout<T>::value, "Raw values must be plain components without hidden state.");
+		if (unlikely(_end - _src < (int)sizeof(T))) {
+			return false;
+		}
+		memcpy((uint8_t *)&r_value, _src, sizeof(T));
+		_src += sizeof(T);
+		return true;
+	}
+
+	template <class P, class T>
+	bool _read_pool(Variant &r_value);
+
+	Error _decode(Variant &r_value, int p_depth);
+
+public:
+	Error decode(const uint8_t *p_data, int p_size, Variant &r_value);
+	Error decode(const PoolByteArray &p_data, Variant &r_value);
+
+	// Bytes consumed by the last successful decode(), data may follow them.
+	_FORCE_INLINE_ int get_bytes_read() const { return _src - _begin; }
+
+	VariantDecoder();
+};
+
+#endif // VARIANT_SERIALIZER_H
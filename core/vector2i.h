@@ -37,6 +37,10 @@
 
 #include <math_funcs.h>
 
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
 class String;
 
 struct Vector2i {
@@ -49,6 +53,69 @@ struct Vector2i {
 		int32_t height;
 	};
 
+	// The layout has to stay packed (8 bytes), as it is shared with the engine through pandemonium_vector2i and PoolVector2iArray.
+
+	inline const int32_t &operator[](int p_axis) const {
+		return p_axis == 0 ? x : y;
+	}
+
+	inline int32_t &operator[](int p_axis) {
+		return p_axis == 0 ? x : y;
+	}
+
+	inline Vector2i operator+(const Vector2i &p_v) const { return Vector2i(x + p_v.x, y + p_v.y); }
+	inline void operator+=(const Vector2i &p_v) {
+		x += p_v.x;
+		y += p_v.y;
+	}
+	inline Vector2i operator-(const Vector2i &p_v) const { return Vector2i(x - p_v.x, y - p_v.y); }
+	inline void operator-=(const Vector2i &p_v) {
+		x -= p_v.x;
+		y -= p_v.y;
+	}
+	inline Vector2i operator*(const Vector2i &p_v) const { return Vector2i(x * p_v.x, y * p_v.y); }
+	inline Vector2i operator*(int32_t p_scalar) const { return Vector2i(x * p_scalar, y * p_scalar); }
+	inline void operator*=(int32_t p_scalar) {
+		x *= p_scalar;
+		y *= p_scalar;
+	}
+	inline Vector2i operator/(const Vector2i &p_v) const { return Vector2i(x / p_v.x, y / p_v.y); }
+	inline Vector2i operator/(int32_t p_scalar) const { return Vector2i(x / p_scalar, y / p_scalar); }
+	inline void operator/=(int32_t p_scalar) {
+		x /= p_scalar;
+		y /= p_scalar;
+	}
+	inline Vector2i operator%(int32_t p_scalar) const { return Vector2i(x % p_scalar, y % p_scalar); }
+	inline Vector2i operator-() const { return Vector2i(-x, -y); }
+
+	inline bool operator==(const Vector2i &p_v) const { return x == p_v.x && y == p_v.y; }
+	inline bool operator!=(const Vector2i &p_v) const { return x != p_v.x || y != p_v.y; }
+	inline bool operator<(const Vector2i &p_v) const { return (x == p_v.x) ? (y < p_v.y) : (x < p_v.x); }
+
+	inline int64_t length_squared() const { return (int64_t)x * x + (int64_t)y * y; }
+
+	inline Vector2i abs() const { return Vector2i(ABS(x), ABS(y)); }
+	inline Vector2i sign() const { return Vector2i((x > 0) - (x < 0), (y > 0) - (y < 0)); }
+	inline Vector2i min(const Vector2i &p_v) const { return Vector2i(MIN(x, p_v.x), MIN(y, p_v.y)); }
+	inline Vector2i max(const Vector2i &p_v) const { return Vector2i(MAX(x, p_v.x), MAX(y, p_v.y)); }
+	inline Vector2i clamp(const Vector2i &p_min, const Vector2i &p_max) const {
+		return Vector2i(CLAMP(x, p_min.x, p_max.x), CLAMP(y, p_min.y, p_max.y));
+	}
+
+	// Division and modulo rounding towards negative infinity, see Vector3i::floor_div(). p_divisor must be positive.
+	inline Vector2i floor_div(int32_t p_divisor) const { return Vector2i(_floor_div(x, p_divisor), _floor_div(y, p_divisor)); }
+	inline Vector2i posmod(int32_t p_divisor) const { return *this - floor_div(p_divisor) * p_divisor; }
+
+	// Morton (Z-order) code over the full 32 bit range of both axes. Codes sort in the same order along each axis as the coordinates.
+	inline uint64_t to_morton() const {
+		return _morton_spread(x) | (_morton_spread(y) << 1);
+	}
+	static inline Vector2i from_morton(uint64_t p_code) {
+		return Vector2i(_morton_compact(p_code), _morton_compact(p_code >> 1));
+	}
+
+	operator String() const;
+
 	inline Vector2i(int p_x, int p_y) {
 		x = p_x;
 		y = p_y;
@@ -59,7 +126,44 @@ struct Vector2i {
 		y = 0;
 	}
 
-	operator String() const;
+private:
+	static inline int32_t _floor_div(int32_t p_value, int32_t p_divisor) {
+		int32_t q = p_value / p_divisor;
+		return (p_value % p_divisor < 0) ? q - 1 : q;
+	}
+
+	// Flipping the sign bit maps signed order to unsigned order.
+	static inline uint64_t _morton_spread(int32_t p_value) {
+		uint64_t v = (uint32_t)p_value ^ 0x80000000u;
+#ifdef __BMI2__
+		return _pdep_u64(v, 0x5555555555555555ULL);
+#else
+		v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+		v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+		v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		v = (v | (v << 2)) & 0x3333333333333333ULL;
+		v = (v | (v << 1)) & 0x5555555555555555ULL;
+		return v;
+#endif
+	}
+
+	static inline int32_t _morton_compact(uint64_t p_code) {
+#ifdef __BMI2__
+		uint64_t v = _pext_u64(p_code, 0x5555555555555555ULL);
+#else
+		uint64_t v = p_code & 0x5555555555555555ULL;
+		v = (v | (v >> 1)) & 0x3333333333333333ULL;
+		v = (v | (v >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+		v = (v | (v >> 4)) & 0x00FF00FF00FF00FFULL;
+		v = (v | (v >> 8)) & 0x0000FFFF0000FFFFULL;
+		v = (v | (v >> 16)) & 0x00000000FFFFFFFFULL;
+#endif
+		return (int32_t)((uint32_t)v ^ 0x80000000u);
+	}
 };
 
-#endif // VECTOR2_H
+inline Vector2i operator*(int32_t p_scalar, const Vector2i &p_vec) {
+	return p_vec * p_scalar;
+}
+
+#endif // VECTOR2I_H
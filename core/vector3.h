@@ -60,6 +60,13 @@ struct Vector3 {
 	static const Vector3 FORWARD;
 	static const Vector3 BACK;
 
+	// Structure of arrays view over vector components, as used by batched functions.
+	struct SoA {
+		real_t *x;
+		real_t *y;
+		real_t *z;
+	};
+
 	union {
 		struct {
 			real_t x;
@@ -37,6 +37,10 @@
 
 #include <math_funcs.h>
 
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
 class String;
 
 struct Vector3i {
@@ -50,6 +54,84 @@ struct Vector3i {
 		int32_t coord[3]; // Not for direct access, use [] operator instead
 	};
 
+	// The layout has to stay packed (12 bytes), as it is shared with the engine through pandemonium_vector3i.
+	// The operators are simple enough for the compiler to vectorise loops over arrays of them.
+
+	inline const int32_t &operator[](int p_axis) const {
+		return coord[p_axis];
+	}
+
+	inline int32_t &operator[](int p_axis) {
+		return coord[p_axis];
+	}
+
+	inline Vector3i operator+(const Vector3i &p_v) const { return Vector3i(x + p_v.x, y + p_v.y, z + p_v.z); }
+	inline void operator+=(const Vector3i &p_v) {
+		x += p_v.x;
+		y += p_v.y;
+		z += p_v.z;
+	}
+	inline Vector3i operator-(const Vector3i &p_v) const { return Vector3i(x - p_v.x, y - p_v.y, z - p_v.z); }
+	inline void operator-=(const Vector3i &p_v) {
+		x -= p_v.x;
+		y -= p_v.y;
+		z -= p_v.z;
+	}
+	inline Vector3i operator*(const Vector3i &p_v) const { return Vector3i(x * p_v.x, y * p_v.y, z * p_v.z); }
+	inline Vector3i operator*(int32_t p_scalar) const { return Vector3i(x * p_scalar, y * p_scalar, z * p_scalar); }
+	inline void operator*=(int32_t p_scalar) {
+		x *= p_scalar;
+		y *= p_scalar;
+		z *= p_scalar;
+	}
+	inline Vector3i operator/(const Vector3i &p_v) const { return Vector3i(x / p_v.x, y / p_v.y, z / p_v.z); }
+	inline Vector3i operator/(int32_t p_scalar) const { return Vector3i(x / p_scalar, y / p_scalar, z / p_scalar); }
+	inline void operator/=(int32_t p_scalar) {
+		x /= p_scalar;
+		y /= p_scalar;
+		z /= p_scalar;
+	}
+	inline Vector3i operator%(int32_t p_scalar) const { return Vector3i(x % p_scalar, y % p_scalar, z % p_scalar); }
+	inline Vector3i operator-() const { return Vector3i(-x, -y, -z); }
+
+	inline bool operator==(const Vector3i &p_v) const { return x == p_v.x && y == p_v.y && z == p_v.z; }
+	inline bool operator!=(const Vector3i &p_v) const { return x != p_v.x || y != p_v.y || z != p_v.z; }
+	inline bool operator<(const Vector3i &p_v) const {
+		if (x == p_v.x) {
+			if (y == p_v.y) {
+				return z < p_v.z;
+			}
+			return y < p_v.y;
+		}
+		return x < p_v.x;
+	}
+
+	inline int64_t length_squared() const { return (int64_t)x * x + (int64_t)y * y + (int64_t)z * z; }
+
+	inline Vector3i abs() const { return Vector3i(ABS(x), ABS(y), ABS(z)); }
+	inline Vector3i sign() const { return Vector3i((x > 0) - (x < 0), (y > 0) - (y < 0), (z > 0) - (z < 0)); }
+	inline Vector3i min(const Vector3i &p_v) const { return Vector3i(MIN(x, p_v.x), MIN(y, p_v.y), MIN(z, p_v.z)); }
+	inline Vector3i max(const Vector3i &p_v) const { return Vector3i(MAX(x, p_v.x), MAX(y, p_v.y), MAX(z, p_v.z)); }
+	inline Vector3i clamp(const Vector3i &p_min, const Vector3i &p_max) const {
+		return Vector3i(CLAMP(x, p_min.x, p_max.x), CLAMP(y, p_min.y, p_max.y), CLAMP(z, p_min.z, p_max.z));
+	}
+
+	// Division and modulo rounding towards negative infinity, e.g. to go from cell to chunk coordinates and back:
+	// floor_div(16) * 16 + posmod(16) == *this, also for negative coordinates. p_divisor must be positive.
+	inline Vector3i floor_div(int32_t p_divisor) const { return Vector3i(_floor_div(x, p_divisor), _floor_div(y, p_divisor), _floor_div(z, p_divisor)); }
+	inline Vector3i posmod(int32_t p_divisor) const { return *this - floor_div(p_divisor) * p_divisor; }
+
+	// Morton (Z-order) code, interleaving the bits of the three axes so that nearby cells get nearby codes.
+	// Axes use 21 bits each, so coordinates must be in [-2^20, 2^20). Codes sort in the same order along each axis as the coordinates.
+	inline uint64_t to_morton() const {
+		return _morton_spread(x) | (_morton_spread(y) << 1) | (_morton_spread(z) << 2);
+	}
+	static inline Vector3i from_morton(uint64_t p_code) {
+		return Vector3i(_morton_compact(p_code), _morton_compact(p_code >> 1), _morton_compact(p_code >> 2));
+	}
+
+	operator String() const;
+
 	inline Vector3i(int p_x, int p_y, int p_z) {
 		x = p_x;
 		y = p_y;
@@ -62,7 +144,44 @@ struct Vector3i {
 		z = 0;
 	}
 
-	operator String() const;
+private:
+	static inline int32_t _floor_div(int32_t p_value, int32_t p_divisor) {
+		int32_t q = p_value / p_divisor;
+		return (p_value % p_divisor < 0) ? q - 1 : q;
+	}
+
+	// Bias by 2^20 so negative coordinates map below positive ones, then spread the bits three positions apart.
+	static inline uint64_t _morton_spread(int32_t p_value) {
+		uint64_t v = (uint64_t)((uint32_t)(p_value + (1 << 20)) & 0x1FFFFF);
+#ifdef __BMI2__
+		return _pdep_u64(v, 0x1249249249249249ULL);
+#else
+		v = (v | (v << 32)) & 0x001F00000000FFFFULL;
+		v = (v | (v << 16)) & 0x001F0000FF0000FFULL;
+		v = (v | (v << 8)) & 0x100F00F00F00F00FULL;
+		v = (v | (v << 4)) & 0x10C30C30C30C30C3ULL;
+		v = (v | (v << 2)) & 0x1249249249249249ULL;
+		return v;
+#endif
+	}
+
+	static inline int32_t _morton_compact(uint64_t p_code) {
+#ifdef __BMI2__
+		uint64_t v = _pext_u64(p_code, 0x1249249249249249ULL);
+#else
+		uint64_t v = p_code & 0x1249249249249249ULL;
+		v = (v | (v >> 2)) & 0x10C30C30C30C30C3ULL;
+		v = (v | (v >> 4)) & 0x100F00F00F00F00FULL;
+		v = (v | (v >> 8)) & 0x001F0000FF0000FFULL;
+		v = (v | (v >> 16)) & 0x001F00000000FFFFULL;
+		v = (v | (v >> 32)) & 0x1FFFFFULL;
+#endif
+		return (int32_t)v - (1 << 20);
+	}
 };
 
-#endif // VECTOR2_H
+inline Vector3i operator*(int32_t p_scalar, const Vector3i &p_vec) {
+	return p_vec * p_scalar;
+}
+
+#endif // VECTOR3I_H
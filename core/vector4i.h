@@ -51,6 +51,62 @@ struct Vector4i {
 		int32_t coord[4]; // Not for direct access, use [] operator instead
 	};
 
+	inline const int32_t &operator[](int p_axis) const {
+		return coord[p_axis];
+	}
+
+	inline int32_t &operator[](int p_axis) {
+		return coord[p_axis];
+	}
+
+	inline Vector4i operator+(const Vector4i &p_v) const { return Vector4i(x + p_v.x, y + p_v.y, z + p_v.z, w + p_v.w); }
+	inline void operator+=(const Vector4i &p_v) {
+		x += p_v.x;
+		y += p_v.y;
+		z += p_v.z;
+		w += p_v.w;
+	}
+	inline Vector4i operator-(const Vector4i &p_v) const { return Vector4i(x - p_v.x, y - p_v.y, z - p_v.z, w - p_v.w); }
+	inline void operator-=(const Vector4i &p_v) {
+		x -= p_v.x;
+		y -= p_v.y;
+		z -= p_v.z;
+		w -= p_v.w;
+	}
+	inline Vector4i operator*(const Vector4i &p_v) const { return Vector4i(x * p_v.x, y * p_v.y, z * p_v.z, w * p_v.w); }
+	inline Vector4i operator*(int32_t p_scalar) const { return Vector4i(x * p_scalar, y * p_scalar, z * p_scalar, w * p_scalar); }
+	inline void operator*=(int32_t p_scalar) {
+		x *= p_scalar;
+		y *= p_scalar;
+		z *= p_scalar;
+		w *= p_scalar;
+	}
+	inline Vector4i operator/(const Vector4i &p_v) const { return Vector4i(x / p_v.x, y / p_v.y, z / p_v.z, w / p_v.w); }
+	inline Vector4i operator/(int32_t p_scalar) const { return Vector4i(x / p_scalar, y / p_scalar, z / p_scalar, w / p_scalar); }
+	inline Vector4i operator%(int32_t p_scalar) const { return Vector4i(x % p_scalar, y % p_scalar, z % p_scalar, w % p_scalar); }
+	inline Vector4i operator-() const { return Vector4i(-x, -y, -z, -w); }
+
+	inline bool operator==(const Vector4i &p_v) const { return x == p_v.x && y == p_v.y && z == p_v.z && w == p_v.w; }
+	inline bool operator!=(const Vector4i &p_v) const { return x != p_v.x || y != p_v.y || z != p_v.z || w != p_v.w; }
+	inline bool operator<(const Vector4i &p_v) const {
+		if (x != p_v.x) {
+			return x < p_v.x;
+		}
+		if (y != p_v.y) {
+			return y < p_v.y;
+		}
+		if (z != p_v.z) {
+			return z < p_v.z;
+		}
+		return w < p_v.w;
+	}
+
+	inline Vector4i abs() const { return Vector4i(ABS(x), ABS(y), ABS(z), ABS(w)); }
+	inline Vector4i min(const Vector4i &p_v) const { return Vector4i(MIN(x, p_v.x), MIN(y, p_v.y), MIN(z, p_v.z), MIN(w, p_v.w)); }
+	inline Vector4i max(const Vector4i &p_v) const { return Vector4i(MAX(x, p_v.x), MAX(y, p_v.y), MAX(z, p_v.z), MAX(w, p_v.w)); }
+
+	operator String() const;
+
 	inline Vector4i(int p_x, int p_y, int p_z, int p_w) {
 		x = p_x;
 		y = p_y;
@@ -64,8 +120,6 @@ struct Vector4i {
 		z = 0;
 		w = 0;
 	}
-
-	operator String() const;
 };
 
-#endif // VECTOR2_H
+#endif // VECTOR4I_H
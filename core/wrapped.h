@@ -38,6 +38,10 @@ class _Wrapped {
 public:
 	pandemonium_object *_owner;
 	size_t _type_tag;
+	// Set when this is the instance of a custom class, whose `_type_tag` is then
+	// the one of its script. Wrappers of engine objects hold the tag of the engine
+	// class, which says nothing about a script attached to the object.
+	bool _is_script_instance = false;
 
 	virtual void free() {}
 };
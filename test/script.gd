@@ -23,6 +23,17 @@ func _initialize():
 	print("Call method ", ref.method(1))
 	if ref.method(1) != 1:
 		return
+	var negative_zero = ref.parse_json_in_locale("-0", "C")
+	print("Parse -0 ", negative_zero)
+	if typeof(negative_zero) != TYPE_REAL or 1.0 / negative_zero > 0:
+		return
+	for locale in ["C", "de_DE.UTF-8", "fr_FR.UTF-8"]:
+		var numbers = ref.parse_json_in_locale("[1.5, 1.5e300, 0.10000000000000000000001]", locale)
+		print("Parse in locale ", locale, " ", numbers)
+		if numbers == null:
+			continue
+		if numbers[0] != 1.5 or numbers[1] != 1.5e300 or numbers[2] != 0.1:
+			return
 	OS.exit_code = 0
 
 
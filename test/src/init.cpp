@@ -30,6 +30,9 @@
 
 #include <pandemonium.h>
 #include <Reference.h>
+#include <json_reader.h>
+
+#include <locale.h>
 
 
 
@@ -58,6 +61,7 @@ public:
 
 	static void _register_methods() {
 		register_method("method", &SimpleClass::method);
+		register_method("parse_json_in_locale", &SimpleClass::parse_json_in_locale);
 
 		/**
 		 * The line below is equivalent to the following GDScript export:
@@ -83,6 +87,21 @@ public:
 	int get_value() const {
 		return _value;
 	}
+
+	/** Returns null if the locale is not installed. */
+	Variant parse_json_in_locale(String p_text, String p_locale) {
+		const String previous = setlocale(LC_NUMERIC, nullptr);
+		if (!setlocale(LC_NUMERIC, p_locale.utf8().get_data())) {
+			return Variant();
+		}
+
+		Variant result;
+		JSONReader reader;
+		reader.parse(p_text, result, JSONReader::PARSE_INTEGERS);
+
+		setlocale(LC_NUMERIC, previous.utf8().get_data());
+		return result;
+	}
 };
 
 /** GDNative Initialize **/